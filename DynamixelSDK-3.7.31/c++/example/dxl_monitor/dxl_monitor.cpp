@@ -119,7 +119,9 @@ void help()
   printf("                               ex) baud 57600 (57600 bps) \n");
   printf("                               ex) baud 1000000 (1 Mbps)  \n");
   printf(" exit                        :Exit this program\n");
-  printf(" scan                        :Outputs the current status of all Dynamixels\n");
+  printf(" scan [BAUD_RATE] ...        :Outputs the current status of all Dynamixels\n");
+  printf("                               at [BAUD_RATE]s, or at the current baudrate\n");
+  printf("                               ex) scan 57600 1000000\n");
   printf(" ping [ID] [ID] ...          :Outputs the current status of [ID]s \n");
   printf(" bp                          :Broadcast ping (Dynamixel Protocol 2.0 only)\n");
   printf(" \n");
@@ -150,51 +152,54 @@ void help()
   printf("\n");
 }
 
-void scan(dynamixel::PortHandler *portHandler, dynamixel::PacketHandler *packetHandler1, dynamixel::PacketHandler *packetHandler2)
+bool scanStep(dynamixel::BusScanner *scanner, const dynamixel::BusScanner::Device *device, void *arg)
 {
-  uint8_t dxl_error;
-  uint16_t dxl_model_num;
-
-  fprintf(stderr, "\n");
-  fprintf(stderr, "Scan Dynamixel Using Protocol 1.0\n");
-  for (int id = 1; id < 253; id++)
+  if (device != 0)
   {
-    if (packetHandler1-> ping(portHandler, id, &dxl_model_num, &dxl_error)== COMM_SUCCESS)
-    {
-      fprintf(stderr, "\n                                          ... SUCCESS \r");
-      fprintf(stderr, " [ID:%.3d] Model No : %.5d \n", id, dxl_model_num);
-    }
-    else
-        fprintf(stderr, ".");
+    fprintf(stderr, "\n                                          ... SUCCESS \r");
+    fprintf(stderr, " [ID:%.3d] Model No : %.5d Protocol %.1f \n", device->id, device->model_number, device->protocol_version);
+  }
+  else
+  {
+    fprintf(stderr, ".");
+  }
 
-    if (kbhit())
-    {
-        char c = getch();
-        if (c == 0x1b)
-        break;
-    }
+  if (kbhit())
+  {
+    char c = getch();
+    if (c == 0x1b) return false;
   }
-  fprintf(stderr, "\n\n");
+  return true;
+}
 
-  fprintf(stderr, "Scan Dynamixel Using Protocol 2.0\n");
-  for (int id = 1; id < 253; id++)
+void scan(dynamixel::PortHandler *portHandler, std::vector<int> &baudrate_list)
+{
+  dynamixel::BusScanner scanner(portHandler);
+  int baudrate = portHandler->getBaudRate();
+
+  scanner.setCallback(scanStep);
+
+  if (baudrate_list.size() == 0)
+    baudrate_list.push_back(baudrate);
+
+  for (unsigned int b = 0; b < baudrate_list.size(); b++)
   {
-    if (packetHandler2-> ping(portHandler, id, &dxl_model_num, &dxl_error)== COMM_SUCCESS)
-    {
-      fprintf(stderr, "\n                                          ... SUCCESS \r");
-      fprintf(stderr, " [ID:%.3d] Model No : %.5d \n", id, dxl_model_num);
-    }
-    else
-    {
-      fprintf(stderr, ".");
-    }
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Scan Dynamixel at %d bps\n", baudrate_list[b]);
 
-    if (kbhit())
+    scanner.clearDeviceList();
+    if (scanner.scan(baudrate_list[b]) < 0)
     {
-      char c = getch();
-      if (c == 0x1b) break;
+      fprintf(stderr, " Failed to change baudrate! \n");
+      continue;
     }
+
+    if (scanner.isAborted() == true)
+      break;
   }
+
+  if (portHandler->getBaudRate() != baudrate)
+    portHandler->setBaudRate(baudrate);
   fprintf(stderr, "\n\n");
 }
 
@@ -448,7 +453,11 @@ int main(int argc, char *argv[])
     }
     else if (strcmp(cmd, "scan") == 0)
     {
-      scan(portHandler, packetHandler1, packetHandler2);
+      std::vector<int> baudrate_list;
+      for (int i = 0; i < num_param; i++)
+        baudrate_list.push_back(atoi(param[i]));
+
+      scan(portHandler, baudrate_list);
     }
     else if (strcmp(cmd, "ping") == 0)
     {
@@ -246,6 +246,9 @@ int main()
     // Initialize Groupsyncread instance for Present Position
     dynamixel::GroupSyncRead groupSyncRead(portHandler, packetHandler, ADDR_PRO_PRESENT_POSITION, LEN_PRO_PRESENT_POSITION);
 
+    // Initialize RegisterCache instance, so that the gripper goal position is sent only when it changes
+    dynamixel::RegisterCache registerCache(portHandler, packetHandler);
+
     POINT cursorPos;
     int mX = ((DXL_STARTING_POSITION_VALUE - DXL2_MINIMUM_POSITION_VALUE) * SCREEN_WIDTH) / (DXL2_MAXIMUM_POSITION_VALUE - DXL2_MINIMUM_POSITION_VALUE);
     int mY = ((DXL_STARTING_POSITION_VALUE - DXL1_MINIMUM_POSITION_VALUE) * SCREEN_HEIGHT) / (DXL1_MAXIMUM_POSITION_VALUE - DXL1_MINIMUM_POSITION_VALUE);
@@ -377,8 +380,7 @@ int main()
     // Syncwrite goal position
     dxl_comm_result = groupSyncWrite.txPacket();
     if (dxl_comm_result != COMM_SUCCESS) printf("%s\n", packetHandler->getTxRxResult(dxl_comm_result));
-    // Clear syncwrite parameter storage
-    groupSyncWrite.clearParam();
+    // Keep syncwrite parameter storage, the loop below only changes the goal positions
 
     while (!GetKeyState(VK_CAPITAL))
     {
@@ -418,11 +420,11 @@ int main()
                         param_goal_position[1] = DXL_HIBYTE(DXL_LOWORD(dm1Y));
                         param_goal_position[2] = DXL_LOBYTE(DXL_HIWORD(dm1Y));
                         param_goal_position[3] = DXL_HIBYTE(DXL_HIWORD(dm1Y));
-                        // Add Dynamixel#2 goal position value to the Syncwrite storage
-                        dxl_addparam_result = groupSyncWrite.addParam(DXL0_ID, param_goal_position);
+                        // Change Dynamixel#2 goal position value in the Syncwrite storage
+                        dxl_addparam_result = groupSyncWrite.changeParam(DXL0_ID, param_goal_position);
                         if (dxl_addparam_result != true)
                         {
-                            fprintf(stderr, "[ID:%03d] groupSyncWrite addparam failed", DXL0_ID);
+                            fprintf(stderr, "[ID:%03d] groupSyncWrite changeparam failed", DXL0_ID);
                             return 0;
                         }
                         // Allocate DXL1 goal position value into byte array
@@ -430,11 +432,11 @@ int main()
                         param_goal_position[1] = DXL_HIBYTE(DXL_LOWORD(dm2Y));
                         param_goal_position[2] = DXL_LOBYTE(DXL_HIWORD(dm2Y));
                         param_goal_position[3] = DXL_HIBYTE(DXL_HIWORD(dm2Y));
-                        // Add Dynamixel#2 goal position value to the Syncwrite storage
-                        dxl_addparam_result = groupSyncWrite.addParam(DXL1_ID, param_goal_position);
+                        // Change Dynamixel#2 goal position value in the Syncwrite storage
+                        dxl_addparam_result = groupSyncWrite.changeParam(DXL1_ID, param_goal_position);
                         if (dxl_addparam_result != true)
                         {
-                            fprintf(stderr, "[ID:%03d] groupSyncWrite addparam failed", DXL1_ID);
+                            fprintf(stderr, "[ID:%03d] groupSyncWrite changeparam failed", DXL1_ID);
                             return 0;
                         }
                     }
@@ -444,28 +446,26 @@ int main()
                     param_goal_position[1] = DXL_HIBYTE(DXL_LOWORD(dm1X));
                     param_goal_position[2] = DXL_LOBYTE(DXL_HIWORD(dm1X));
                     param_goal_position[3] = DXL_HIBYTE(DXL_HIWORD(dm1X));
-                    // Add Dynamixel#1 goal position value to the Syncwrite storage
-                    dxl_addparam_result = groupSyncWrite.addParam(DXL2_ID, param_goal_position);
+                    // Change Dynamixel#1 goal position value in the Syncwrite storage
+                    dxl_addparam_result = groupSyncWrite.changeParam(DXL2_ID, param_goal_position);
                     if (dxl_addparam_result != true)
                     {
-                        fprintf(stderr, "[ID:%03d] groupSyncWrite addparam failed", DXL2_ID);
+                        fprintf(stderr, "[ID:%03d] groupSyncWrite changeparam failed", DXL2_ID);
                         return 0;
                     }
                     // Syncwrite goal position
                     dxl_comm_result = groupSyncWrite.txPacket();
                     if (dxl_comm_result != COMM_SUCCESS) printf("%s\n", packetHandler->getTxRxResult(dxl_comm_result));
-                    // Clear syncwrite parameter storage
-                    groupSyncWrite.clearParam();
                 }
                 if (collector.MyPose == 1 || GetAsyncKeyState(VK_LCONTROL) != 0)              //If up-key is pressed, Open the gripper
                 {
-                    packetHandler->write4ByteTxRx(portHandler, 4, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[0], &dxl_error);
-                    packetHandler->write4ByteTxRx(portHandler, 5, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[0], &dxl_error);
+                    registerCache.write4ByteTxRx(4, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[0], &dxl_error);
+                    registerCache.write4ByteTxRx(5, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[0], &dxl_error);
                 }
                 else if (collector.MyPose == 0 || GetAsyncKeyState(VK_LSHIFT) != 0)       //If down-key is pressed, close the gripper
                 {
-                    packetHandler->write4ByteTxRx(portHandler, 4, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[1], &dxl_error);
-                    packetHandler->write4ByteTxRx(portHandler, 5, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[1], &dxl_error);
+                    registerCache.write4ByteTxRx(4, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[1], &dxl_error);
+                    registerCache.write4ByteTxRx(5, ADDR_PRO_GOAL_POSITION, dxl_openClose_position[1], &dxl_error);
                 }
             }
         }
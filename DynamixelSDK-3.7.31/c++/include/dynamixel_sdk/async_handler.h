@@ -0,0 +1,163 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for running the transactions of a port without blocking the caller
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_ASYNCHANDLER_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_ASYNCHANDLER_H_
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+
+#include <functional>
+#include <future>
+#include "port_handler.h"
+#include "packet_handler.h"
+#include "group_sync_read.h"
+#include "group_sync_write.h"
+#include "group_bulk_read.h"
+#include "group_bulk_write.h"
+#include "cycle_plan.h"
+#include "transaction_queue.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that runs the PacketHandler and Group transactions of a port on the I/O thread of a TransactionQueue
+/// @description Each function returns at once with a future of the communication result, and calls the callback, if any, on the I/O thread
+/// @description when the transaction ends. The data read is in the buffers of the caller, or in the Group instance, when the future is ready.
+/// @description The buffers and the Group instances should be kept and not be used by the caller until then.
+/// @description The transactions run in the order of the calls, and call the same PacketHandler and Group functions as the blocking API.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC AsyncHandler
+{
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The type of the function called on the I/O thread when a transaction ends
+  /// @description The function should not wait for another future of the same AsyncHandler.
+  /// @param result Communication result
+  /// @param arg Argument given with the function
+  ////////////////////////////////////////////////////////////////////////////////
+  typedef void (*Callback)(int result, void *arg);
+
+ private:
+  PortHandler      *port_;
+  PacketHandler    *ph_;
+  TransactionQueue  queue_;
+
+  std::future<int>  submit(const std::function<int(PortHandler *)> &job, Callback callback, void *arg);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of AsyncHandler and starts its I/O thread
+  /// @param port PortHandler instance
+  /// @param ph PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  AsyncHandler(PortHandler *port, PacketHandler *ph);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that runs the transactions already requested, and stops the I/O thread
+  ////////////////////////////////////////////////////////////////////////////////
+  ~AsyncHandler() { queue_.stop(); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PortHandler instance
+  /// @return PortHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PortHandler      *getPortHandler()      { return port_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PacketHandler instance
+  /// @return PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PacketHandler    *getPacketHandler()    { return ph_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the TransactionQueue of the I/O thread, to limit it or to submit other transactions
+  /// @return TransactionQueue instance
+  ////////////////////////////////////////////////////////////////////////////////
+  TransactionQueue *getTransactionQueue() { return &queue_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that requests PacketHandler::ping()
+  /// @param id Dynamixel ID
+  /// @param model_number Buffer for the model number, or 0
+  /// @param error Buffer for Dynamixel hardware error, or 0
+  /// @param callback Function called on the I/O thread, or 0
+  /// @param arg Argument given to the function
+  /// @return Future of the communication result which comes from PacketHandler::ping(),
+  /// @return   or of COMM_PORT_BUSY when the queue is full, or of COMM_NOT_AVAILABLE when the queue is stopped
+  ////////////////////////////////////////////////////////////////////////////////
+  std::future<int> ping(uint8_t id, uint16_t *model_number, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that request PacketHandler::readTxRx(), read1ByteTxRx(), read2ByteTxRx() and read4ByteTxRx()
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for read
+  /// @param length Length of the data for read
+  /// @param data Buffer for the data read
+  /// @param error Buffer for Dynamixel hardware error, or 0
+  /// @param callback Function called on the I/O thread, or 0
+  /// @param arg Argument given to the function
+  /// @return Future of the communication result which comes from the PacketHandler function,
+  /// @return   or of COMM_PORT_BUSY when the queue is full, or of COMM_NOT_AVAILABLE when the queue is stopped
+  ////////////////////////////////////////////////////////////////////////////////
+  std::future<int> readTxRx       (uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+  std::future<int> read1ByteTxRx  (uint8_t id, uint16_t address, uint8_t *data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+  std::future<int> read2ByteTxRx  (uint8_t id, uint16_t address, uint16_t *data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+  std::future<int> read4ByteTxRx  (uint8_t id, uint16_t address, uint32_t *data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that request PacketHandler::writeTxRx(), write1ByteTxRx(), write2ByteTxRx() and write4ByteTxRx()
+  /// @description The data is copied, so the caller may change its buffer at once.
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param length Length of the data for write
+  /// @param data Data for write
+  /// @param error Buffer for Dynamixel hardware error, or 0
+  /// @param callback Function called on the I/O thread, or 0
+  /// @param arg Argument given to the function
+  /// @return Future of the communication result which comes from the PacketHandler function,
+  /// @return   or of COMM_PORT_BUSY when the queue is full, or of COMM_NOT_AVAILABLE when the queue is stopped
+  ////////////////////////////////////////////////////////////////////////////////
+  std::future<int> writeTxRx      (uint8_t id, uint16_t address, uint16_t length, const uint8_t *data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+  std::future<int> write1ByteTxRx (uint8_t id, uint16_t address, uint8_t data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+  std::future<int> write2ByteTxRx (uint8_t id, uint16_t address, uint16_t data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+  std::future<int> write4ByteTxRx (uint8_t id, uint16_t address, uint32_t data, uint8_t *error = 0, Callback callback = 0, void *arg = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that request the txRxPacket() of GroupSyncRead, GroupBulkRead and CyclePlan, and the txPacket() of GroupSyncWrite and GroupBulkWrite
+  /// @description The Group instance should be used with the same port, and should not be used by the caller until the future is ready.
+  /// @param group Group instance
+  /// @param callback Function called on the I/O thread, or 0
+  /// @param arg Argument given to the function
+  /// @return Future of the communication result which comes from the Group function,
+  /// @return   or of COMM_PORT_BUSY when the queue is full, or of COMM_NOT_AVAILABLE when the queue is stopped
+  ////////////////////////////////////////////////////////////////////////////////
+  std::future<int> txRxPacket     (GroupSyncRead &group, Callback callback = 0, void *arg = 0);
+  std::future<int> txRxPacket     (GroupBulkRead &group, Callback callback = 0, void *arg = 0);
+  std::future<int> txRxPacket     (CyclePlan &plan, Callback callback = 0, void *arg = 0);
+  std::future<int> txPacket       (GroupSyncWrite &group, Callback callback = 0, void *arg = 0);
+  std::future<int> txPacket       (GroupBulkWrite &group, Callback callback = 0, void *arg = 0);
+};
+
+}
+
+#endif
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_ASYNCHANDLER_H_ */
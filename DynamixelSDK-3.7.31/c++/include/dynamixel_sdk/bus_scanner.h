@@ -0,0 +1,214 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for finding Dynamixels on a bus over baudrates and protocols
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_BUSSCANNER_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_BUSSCANNER_H_
+
+
+#include <vector>
+#include "port_handler.h"
+#include "packet_handler.h"
+#include "response_time_estimator.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that finds the Dynamixels on a bus over baudrates and protocols
+/// @description For Protocol 2.0, the class sends one broadcast ping and pings only the IDs which answered to get the model number.
+/// @description For Protocol 1.0, which has no broadcast ping, the class pings every ID with the timeout
+/// @description estimated by a ResponseTimeEstimator from the Dynamixels which already answered at the baudrate.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC BusScanner
+{
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The structure of a Dynamixel found by BusScanner
+  ////////////////////////////////////////////////////////////////////////////////
+  struct Device
+  {
+    uint8_t   id;
+    uint16_t  model_number;
+    uint8_t   firmware_version;
+    float     protocol_version;
+    int       baudrate;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The type of the function called after each step of the scan
+  /// @description A step is the ping of an ID, or the broadcast ping of Protocol 2.0. The function may show the progress.
+  /// @param scanner BusScanner instance
+  /// @param device Dynamixel found at the step, or 0
+  /// @param arg Argument given to BusScanner::setCallback()
+  /// @return false to stop the scan, or true
+  ////////////////////////////////////////////////////////////////////////////////
+  typedef bool (*Callback)(BusScanner *scanner, const Device *device, void *arg);
+
+ private:
+  PortHandler            *port_;
+  Callback                callback_;
+  void                   *arg_;
+  bool                    is_aborted_;
+  ResponseTimeEstimator   estimator_;
+
+  std::vector<int>        baudrate_list_;
+  bool                    protocol1_;
+  bool                    protocol2_;
+  uint8_t                 first_id_;
+  uint8_t                 last_id_;
+  double                  idle_time_;
+
+  std::vector<Device>     device_list_;
+
+  void    addDevice(uint8_t id, uint16_t model_number, uint8_t firmware_version, float protocol_version, int baudrate);
+  bool    verifyDevices(unsigned int begin, unsigned int end);
+  bool    step(const Device *device);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of BusScanner
+  /// @description The scanner uses the baudrate of the port and both protocols until they are set.
+  /// @param port PortHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  BusScanner(PortHandler *port);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the baudrates to scan
+  /// @param baudrate_list Baudrates, or an empty list for the baudrate of the port
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setBaudRateList(const std::vector<int> &baudrate_list) { baudrate_list_ = baudrate_list; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the protocols to scan
+  /// @param protocol1 Whether to scan by Protocol 1.0
+  /// @param protocol2 Whether to scan by Protocol 2.0
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setProtocol(bool protocol1, bool protocol2) { protocol1_ = protocol1; protocol2_ = protocol2; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the range of IDs to scan
+  /// @param first_id First Dynamixel ID
+  /// @param last_id Last Dynamixel ID (not greater than MAX_ID)
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setIdRange(uint8_t first_id, uint8_t last_id);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the idle time of the Protocol 2.0 broadcast ping
+  /// @description See PacketHandler::broadcastPing(). The default 0 waits for all IDs.
+  /// @param idle_time Time in msec to wait for the next byte, or 0 to wait for all IDs
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setIdleTime(double idle_time) { idle_time_ = idle_time; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the timeout of the pings before any Dynamixel has answered at the baudrate
+  /// @description After a Dynamixel answered, the timeout is estimated from the response times.
+  /// @param ping_timeout Timeout in msec, or 0 to use the packet timeout of the port
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setPingTimeout(double ping_timeout) { estimator_.setDefaultTimeout(ping_timeout > 0.0 ? ping_timeout : -1.0); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the function called after each step of the scan
+  /// @param callback Function, or 0 for none
+  /// @param arg Argument given to the function
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setCallback(Callback callback, void *arg = 0) { callback_ = callback; arg_ = arg; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that scans all the baudrates
+  /// @description The function clears the device list, calls BusScanner::scan(int) for each baudrate until the scan is stopped,
+  /// @description and restores the baudrate of the port.
+  /// @return Number of Dynamixels found
+  ////////////////////////////////////////////////////////////////////////////////
+  int     scan();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that scans a baudrate
+  /// @description The function sets the baudrate of the port, and adds the Dynamixels found to the device list.
+  /// @description The ResponseTimeEstimator of the port is replaced by the one of the scanner during the scan.
+  /// @description The scan ends early when the function set by BusScanner::setCallback() returns false.
+  /// @param baudrate Baudrate
+  /// @return -1
+  /// @return   when it fails to set the baudrate
+  /// @return or Number of Dynamixels found at the baudrate
+  ////////////////////////////////////////////////////////////////////////////////
+  int     scan(int baudrate);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether the Dynamixels in the device list are still on the bus
+  /// @description The function sends one Sync Read of the model number and the firmware version per baudrate for Protocol 2.0,
+  /// @description and reads them from each Dynamixel for Protocol 1.0. The baudrate of the port is restored.
+  /// @return false
+  /// @return   when the device list is empty, or a Dynamixel does not answer or has another model number or firmware version
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    verifyDeviceList();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether the last scan was stopped by the function set by BusScanner::setCallback()
+  /// @return true
+  /// @return   when the scan was stopped
+  /// @return or false
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isAborted() { return is_aborted_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that saves the device list to a file
+  /// @description Each line of the file has the port name, baudrate, protocol version, ID, model number and firmware version.
+  /// @param file_name File name
+  /// @return false
+  /// @return   when it fails to write the file
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    saveDeviceList(const char *file_name);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that loads the device list from a file saved by BusScanner::saveDeviceList()
+  /// @param file_name File name
+  /// @return false
+  /// @return   when it fails to read the file, or the file is for another port (the device list is cleared)
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    loadDeviceList(const char *file_name);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that takes the device list from a file, and scans only when the file does not match the bus
+  /// @description The function calls BusScanner::loadDeviceList() and BusScanner::verifyDeviceList().
+  /// @description If either fails, it calls BusScanner::scan() and saves the new device list to the file unless the scan was stopped.
+  /// @param file_name File name
+  /// @return Number of Dynamixels in the device list
+  ////////////////////////////////////////////////////////////////////////////////
+  int     scanWithCache(const char *file_name);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the Dynamixels found
+  /// @return Device list in the order of baudrate, protocol and ID
+  ////////////////////////////////////////////////////////////////////////////////
+  const std::vector<Device> &getDeviceList() { return device_list_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the device list
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearDeviceList() { device_list_.clear(); }
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_BUSSCANNER_H_ */
@@ -0,0 +1,169 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for running a control cycle at a fixed rate
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CONTROLLOOP_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CONTROLLOOP_H_
+
+
+#include <vector>
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+#include <atomic>
+#endif
+#include "cycle_plan.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that runs a CyclePlan and a callback at a fixed rate
+/// @description Each cycle starts at an absolute deadline, so the time of a cycle does not shift the next ones.
+/// @description A cycle which ends after the next deadline is an overrun, and the deadlines which were missed are skipped.
+/// @description The class records the jitter (delay of the wake-up from the deadline) and the cycle time in histograms.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC ControlLoop
+{
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The type of the function called in each cycle after the writes and reads of the CyclePlan
+  /// @description The function may get the data of the CyclePlan, set the data for the next cycle, and call ControlLoop::stop().
+  /// @param loop ControlLoop instance
+  /// @param result Communication result of CyclePlan::txRxPacket(), or COMM_SUCCESS without CyclePlan
+  /// @param arg Argument given to ControlLoop::setCallback()
+  ////////////////////////////////////////////////////////////////////////////////
+  typedef void (*Callback)(ControlLoop *loop, int result, void *arg);
+
+ private:
+  CyclePlan  *plan_;
+  Callback    callback_;
+  void       *arg_;
+
+  int64_t     period_;          // nsec
+  int64_t     deadline_;        // nsec, 0 before the first cycle
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  volatile bool     is_stopping_;   // set by ControlLoop::stop(), taken by ControlLoop::run()
+#else
+  std::atomic<bool> is_stopping_;   // set by ControlLoop::stop() on any thread, taken by ControlLoop::run()
+#endif
+
+  bool        takeStop();
+
+  double      bin_width_;       // usec
+  std::vector<unsigned long> jitter_histogram_;
+  std::vector<unsigned long> cycle_time_histogram_;
+
+  unsigned long cycle_count_;
+  unsigned long overrun_count_;
+  unsigned long missed_count_;
+  double      max_jitter_;      // usec
+  double      sum_jitter_;      // usec
+  double      max_cycle_time_;  // usec
+  double      sum_cycle_time_;  // usec
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of ControlLoop
+  /// @param plan CyclePlan instance, or 0 to run the callback only
+  /// @param rate Rate in Hz (for example, 250, 500 or 1000)
+  ////////////////////////////////////////////////////////////////////////////////
+  ControlLoop(CyclePlan *plan, double rate);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the function called in each cycle
+  /// @param callback Function, or 0 for none
+  /// @param arg Argument given to the function
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setCallback (Callback callback, void *arg = 0) { callback_ = callback; arg_ = arg; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the rate
+  /// @param rate Rate in Hz
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setRate     (double rate);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the period
+  /// @return Period in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getPeriod   () { return period_ / 1000000.0; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the bins of the histograms, and clears the statistics
+  /// @description The jitter histogram has bins of bin_width usec. The cycle time histogram divides the period into bin_count bins.
+  /// @description The last bin of each histogram also counts the values over its range.
+  /// @param bin_width Width of a bin of the jitter histogram in usec (default 10)
+  /// @param bin_count Number of bins (default 50)
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setHistogram(double bin_width, int bin_count);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether the bus can sustain the rate
+  /// @description The function prints a warning when the cycle time estimated by CyclePlan::getCycleTime() is longer than the period.
+  /// @return false
+  /// @return   when the estimated cycle time is longer than the period
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    checkRate   ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits for the next deadline and runs a cycle
+  /// @description The first call starts the cycles without waiting.
+  /// @return false
+  /// @return   when the cycle overran the period
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    spinOnce    ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that runs the cycles until ControlLoop::stop() is called or the number of cycles is reached
+  /// @description The function calls ControlLoop::checkRate() first, and prints a warning at the end when any cycle overran.
+  /// @param cycles Number of cycles, or 0 to run until ControlLoop::stop() is called
+  /// @return Number of cycles run
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long run   (unsigned long cycles = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes ControlLoop::run() return after the current cycle
+  /// @description The function may be called by another thread. A stop before ControlLoop::run() is kept, and makes the next run return at once.
+  ////////////////////////////////////////////////////////////////////////////////
+  void    stop        () { is_stopping_ = true; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the statistics, and starts the next cycles without waiting
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearStatistics();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that return the statistics since ControlLoop::clearStatistics()
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long getCycleCount     () { return cycle_count_; }
+  unsigned long getOverrunCount   () { return overrun_count_; }
+  unsigned long getMissedCount    () { return missed_count_; }      ///< Number of deadlines skipped after the overruns
+  double        getMaxJitter      () { return max_jitter_; }        ///< usec
+  double        getMeanJitter     () { return (cycle_count_ > 0) ? sum_jitter_ / cycle_count_ : 0.0; }       ///< usec
+  double        getMaxCycleTime   () { return max_cycle_time_; }    ///< usec
+  double        getMeanCycleTime  () { return (cycle_count_ > 0) ? sum_cycle_time_ / cycle_count_ : 0.0; }   ///< usec
+  const std::vector<unsigned long> &getJitterHistogram   () { return jitter_histogram_; }
+  const std::vector<unsigned long> &getCycleTimeHistogram() { return cycle_time_histogram_; }
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CONTROLLOOP_H_ */
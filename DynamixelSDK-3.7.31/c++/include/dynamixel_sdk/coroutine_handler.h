@@ -0,0 +1,654 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for awaiting the transactions of several ports from C++20 coroutines on one thread
+/// @description The file is header only and is not included by dynamixel_sdk.h, so the library itself keeps building as C++11.
+/// @description The application including it is built with -std=c++20 and linked with the library as usual.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_COROUTINEHANDLER_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_COROUTINEHANDLER_H_
+
+#if !defined(__linux__)
+#error "coroutine_handler.h is only available on Linux"
+#elif !defined(__cpp_impl_coroutine)
+#error "coroutine_handler.h needs C++20 coroutines (-std=c++20)"
+#endif
+
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <array>
+#include <cmath>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <utility>
+#include <vector>
+#include "port_handler_linux.h"
+#include "packet_handler.h"
+#include "group_sync_read.h"
+#include "group_sync_write.h"
+#include "group_bulk_read.h"
+#include "group_bulk_write.h"
+#include "group_indirect_sync_read.h"
+
+namespace dynamixel
+{
+
+class PortReactor;
+template <typename T> class Task;
+
+namespace detail
+{
+
+struct TaskPromiseBase
+{
+  std::coroutine_handle<> continuation;   // the coroutine awaiting the task, or none for a task run by PortReactor::spawn()
+
+  struct FinalAwaiter
+  {
+    bool await_ready() noexcept { return false; }
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+    {
+      std::coroutine_handle<> continuation = handle.promise().continuation;
+      return (continuation) ? continuation : std::noop_coroutine();
+    }
+    void await_resume() noexcept { }
+  };
+
+  std::suspend_always initial_suspend() noexcept { return std::suspend_always(); }
+  FinalAwaiter        final_suspend() noexcept { return FinalAwaiter(); }
+  void                unhandled_exception() { std::terminate(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase
+{
+  T value;
+
+  Task<T> get_return_object();
+  void    return_value(T v) { value = std::move(v); }
+  T       result() { return std::move(value); }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase
+{
+  Task<void> get_return_object();
+  void       return_void() { }
+  void       result() { }
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class of a coroutine which awaits Dynamixel transactions
+/// @description The coroutine starts when it is awaited by another coroutine, or when it is given to PortReactor::spawn().
+/// @description It returns T to the coroutine awaiting it.
+////////////////////////////////////////////////////////////////////////////////
+template <typename T = void>
+class Task
+{
+ public:
+  typedef detail::TaskPromise<T> promise_type;
+
+ private:
+  friend class PortReactor;
+  std::coroutine_handle<promise_type> handle_;
+
+ public:
+  struct Awaiter
+  {
+    std::coroutine_handle<promise_type> handle;
+
+    bool await_ready() noexcept { return !handle || handle.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+      handle.promise().continuation = caller;
+      return handle;
+    }
+    T await_resume() { return handle.promise().result(); }
+  };
+
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) { }
+  Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) { }
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  ~Task()
+  {
+    if (handle_)
+      handle_.destroy();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether the coroutine has returned
+  /// @return true when the coroutine has returned
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isDone() { return !handle_ || handle_.done(); }
+
+  Awaiter operator co_await() noexcept { return Awaiter{handle_}; }
+};
+
+template <typename T>
+inline Task<T> detail::TaskPromise<T>::get_return_object()
+{
+  return Task<T>(std::coroutine_handle<TaskPromise<T> >::from_promise(*this));
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object()
+{
+  return Task<void>(std::coroutine_handle<TaskPromise<void> >::from_promise(*this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class of a transaction awaited by a coroutine, which returns the communication result
+/// @description The transaction starts when it is awaited. The transactions of a port run one by one in the order awaited,
+/// @description and the transactions of different ports run at the same time.
+/// @description The awaiting coroutine is resumed by PortReactor when the status packets are received or the packet timeout passes.
+////////////////////////////////////////////////////////////////////////////////
+class Transfer
+{
+ private:
+  friend class PortReactor;
+
+  PortReactor             *reactor_;
+  PortHandler             *port_;
+  std::function<int()>     start_;
+  std::function<int()>     poll_;
+  std::coroutine_handle<>  waiter_;
+  int                      result_;
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of Transfer
+  /// @param reactor PortReactor instance which runs the transaction
+  /// @param port PortHandler instance of the transaction
+  /// @param start Function which transmits the instruction packet, and returns COMM_RX_WAITING while a status packet is expected or the communication result
+  /// @param poll Function which receives without waiting, as GroupSyncRead::pollRx(), and returns COMM_RX_WAITING or the communication result
+  ////////////////////////////////////////////////////////////////////////////////
+  Transfer(PortReactor *reactor, PortHandler *port, std::function<int()> start, std::function<int()> poll = std::function<int()>())
+    : reactor_(reactor),
+      port_(port),
+      start_(std::move(start)),
+      poll_(std::move(poll)),
+      result_(COMM_TX_FAIL)
+  {
+  }
+  Transfer(const Transfer &) = delete;
+  Transfer &operator=(const Transfer &) = delete;
+
+  bool  await_ready() noexcept { return false; }
+  bool  await_suspend(std::coroutine_handle<> waiter);
+  int   await_resume() noexcept { return result_; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that runs the transfers of several ports on one thread, and resumes the coroutines awaiting them
+/// @description PortReactor waits on the file descriptors of the ports by epoll until bytes come or the earliest packet timeout passes,
+/// @description then receives the status packets without waiting by the poll functions of PacketHandler and the Group classes.
+/// @description A port is added when a transfer on it is awaited first. The ports should be used only by the thread of PortReactor.
+////////////////////////////////////////////////////////////////////////////////
+class PortReactor
+{
+ private:
+  struct Channel
+  {
+    PortHandlerLinux       *port;
+    int                     fd;
+    std::deque<Transfer *>  queue;    // the first one is running
+  };
+
+  int                     epoll_fd_;
+  std::list<Channel>      channels_;  // the address of each Channel is the data of its epoll event
+  std::deque<Transfer *>  ready_;     // the transfers ended, whose coroutines are not resumed yet
+  std::list<Task<void> >  tasks_;
+
+  Channel *getChannel(PortHandler *port)
+  {
+    for (std::list<Channel>::iterator it = channels_.begin(); it != channels_.end(); ++it)
+    {
+      if (it->port != port)
+        continue;
+
+      // PortHandlerLinux::setBaudRate() opens the port again with another file descriptor
+      if (it->fd != it->port->getSocketFd() && watch(&*it) == false)
+        return 0;
+      return &*it;
+    }
+
+    PortHandlerLinux *port_linux = dynamic_cast<PortHandlerLinux *>(port);
+    if (port_linux == 0)
+      return 0;
+
+    Channel channel;
+    channel.port = port_linux;
+    channel.fd   = -1;
+    channels_.push_back(channel);
+    if (watch(&channels_.back()) == false)
+    {
+      channels_.pop_back();
+      return 0;
+    }
+    return &channels_.back();
+  }
+
+  bool watch(Channel *channel)
+  {
+    channel->fd = channel->port->getSocketFd();
+    if (channel->fd < 0)
+      return false;
+
+    struct epoll_event event;
+    event.events   = EPOLLIN;
+    event.data.ptr = channel;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, channel->fd, &event) != 0 &&
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, channel->fd, &event) != 0)
+      return false;
+    return true;
+  }
+
+  void finish(Transfer *transfer, int result)
+  {
+    transfer->result_ = result;
+    ready_.push_back(transfer);
+  }
+
+  // starts the transfers waiting on the port until one of them expects a status packet
+  void startNext(Channel *channel)
+  {
+    while (channel->queue.empty() == false)
+    {
+      Transfer *transfer = channel->queue.front();
+      int result = transfer->start_();
+      if (result == COMM_RX_WAITING)
+        return;
+
+      channel->queue.pop_front();
+      finish(transfer, result);
+    }
+  }
+
+  void resumeReady()
+  {
+    while (ready_.empty() == false)
+    {
+      Transfer *transfer = ready_.front();
+      ready_.pop_front();
+      transfer->waiter_.resume();
+    }
+  }
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of PortReactor
+  ////////////////////////////////////////////////////////////////////////////////
+  PortReactor() : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)) { }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that destroys the coroutines not returned yet, and closes the epoll file descriptor
+  ////////////////////////////////////////////////////////////////////////////////
+  ~PortReactor()
+  {
+    tasks_.clear();
+    if (epoll_fd_ >= 0)
+      close(epoll_fd_);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the epoll file descriptor
+  /// @description The descriptor becomes readable when bytes come on a port, so that another event loop can watch it
+  /// @description and call PortReactor::runOnce() with 0 msec.
+  /// @return File descriptor
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getFd() { return epoll_fd_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the number of coroutines started by PortReactor::spawn() which have not returned
+  /// @return Number of coroutines
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getTaskCount() { return (int)tasks_.size(); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that starts a coroutine, which runs until it awaits a transfer
+  /// @description PortReactor keeps the coroutine until it returns.
+  /// @param task Task instance
+  ////////////////////////////////////////////////////////////////////////////////
+  void    spawn(Task<void> task)
+  {
+    tasks_.push_back(std::move(task));
+    tasks_.back().handle_.resume();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that starts a transfer, or puts it after the transfers running on the same port
+  /// @description The function is called by Transfer when it is awaited.
+  /// @param transfer Transfer instance
+  /// @return false
+  /// @return   when the transfer has ended at once, and the coroutine goes on without suspending
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    submit(Transfer *transfer)
+  {
+    Channel *channel = getChannel(transfer->port_);
+    if (channel == 0)
+    {
+      transfer->result_ = COMM_NOT_AVAILABLE;
+      return false;
+    }
+
+    if (channel->queue.empty() == false)
+    {
+      channel->queue.push_back(transfer);
+      return true;
+    }
+
+    int result = transfer->start_();
+    if (result != COMM_RX_WAITING)
+    {
+      transfer->result_ = result;
+      return false;
+    }
+
+    channel->queue.push_back(transfer);
+    return true;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits once for bytes or the earliest packet timeout, and resumes the coroutines whose transfers ended
+  /// @param max_wait Longest time to wait in msec, or -1 to wait until the earliest packet timeout
+  /// @return false
+  /// @return   when no transfer is running
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    runOnce(int max_wait = -1)
+  {
+    resumeReady();
+
+    int  timeout    = max_wait;
+    bool is_running = false;
+    for (std::list<Channel>::iterator it = channels_.begin(); it != channels_.end(); ++it)
+    {
+      if (it->queue.empty() == true)
+        continue;
+
+      double remaining_time = it->port->getPacketRemainingTime();
+      int    wait           = (remaining_time > 0.0) ? (int)std::ceil(remaining_time) : 0;
+      if (timeout < 0 || wait < timeout)
+        timeout = wait;
+      is_running = true;
+    }
+
+    if (is_running == true)
+    {
+      struct epoll_event events[16];
+      int count = epoll_wait(epoll_fd_, events, 16, timeout);
+      for (int i = 0; i < count; i++)
+      {
+        // the bytes which come while no transfer runs on the port are for nobody
+        Channel *channel = (Channel *)events[i].data.ptr;
+        if (channel->queue.empty() == true)
+          channel->port->clearPort();
+      }
+
+      // the running transfers are polled all, as a poll without bytes only checks the packet timeout
+      for (std::list<Channel>::iterator it = channels_.begin(); it != channels_.end(); ++it)
+      {
+        if (it->queue.empty() == true)
+          continue;
+
+        Transfer *transfer = it->queue.front();
+        int result = transfer->poll_();
+        if (result == COMM_RX_WAITING)
+          continue;
+
+        it->queue.pop_front();
+        finish(transfer, result);
+        startNext(&*it);
+      }
+    }
+
+    resumeReady();
+    tasks_.remove_if([](Task<void> &task) { return task.isDone(); });
+
+    return is_running;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that calls PortReactor::runOnce() until no transfer is running
+  /// @description The coroutines started by PortReactor::spawn() have returned by then, unless they await something else.
+  ////////////////////////////////////////////////////////////////////////////////
+  void    run()
+  {
+    while (runOnce() == true)
+      ;
+  }
+};
+
+inline bool Transfer::await_suspend(std::coroutine_handle<> waiter)
+{
+  waiter_ = waiter;
+  return reactor_->submit(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that makes the PacketHandler and Group transactions of a port awaitable
+/// @description Each function returns a Transfer, which is run by PortReactor when it is awaited by co_await.
+/// @description The buffers and the Group instances should be kept until the coroutine is resumed.
+////////////////////////////////////////////////////////////////////////////////
+class CoroutineHandler
+{
+ private:
+  PortReactor    *reactor_;
+  PortHandler    *port_;
+  PacketHandler  *ph_;
+
+  // a status packet is expected once the instruction packet is sent
+  static int waitStatus(int result) { return (result == COMM_SUCCESS) ? COMM_RX_WAITING : result; }
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of CoroutineHandler
+  /// @param reactor PortReactor instance
+  /// @param port PortHandler instance
+  /// @param ph PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  CoroutineHandler(PortReactor *reactor, PortHandler *port, PacketHandler *ph)
+    : reactor_(reactor),
+      port_(port),
+      ph_(ph)
+  {
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PortReactor instance
+  /// @return PortReactor instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PortReactor   *getPortReactor()   { return reactor_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PortHandler instance
+  /// @return PortHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PortHandler   *getPortHandler()   { return port_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PacketHandler instance
+  /// @return PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PacketHandler *getPacketHandler() { return ph_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that pings Dynamixel by PacketHandler::pingTx() and PacketHandler::pollReadRx()
+  /// @description The model number may be read from address 0 by CoroutineHandler::read2ByteTxRx().
+  /// @param id Dynamixel ID
+  /// @param error Buffer for Dynamixel hardware error, or 0
+  /// @return Transfer of the communication result
+  ////////////////////////////////////////////////////////////////////////////////
+  Transfer ping(uint8_t id, uint8_t *error = 0)
+  {
+    PortHandler   *port = port_;
+    PacketHandler *ph   = ph_;
+    return Transfer(reactor_, port_,
+                    [=]() { return waitStatus(ph->pingTx(port, id)); },
+                    [=]() { return ph->pollReadRx(port, id, 0, 0, error); });
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that read by PacketHandler::readTx() and PacketHandler::pollReadRx()
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for read
+  /// @param length Length of the data for read
+  /// @param data Buffer for the data read
+  /// @param error Buffer for Dynamixel hardware error, or 0
+  /// @return Transfer of the communication result
+  ////////////////////////////////////////////////////////////////////////////////
+  Transfer readTxRx(uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error = 0)
+  {
+    PortHandler   *port = port_;
+    PacketHandler *ph   = ph_;
+    return Transfer(reactor_, port_,
+                    [=]() { return waitStatus(ph->readTx(port, id, address, length)); },
+                    [=]() { return ph->pollReadRx(port, id, length, data, error); });
+  }
+
+  Transfer read1ByteTxRx(uint8_t id, uint16_t address, uint8_t *data, uint8_t *error = 0)
+  {
+    return readTxRx(id, address, 1, data, error);
+  }
+
+  Transfer read2ByteTxRx(uint8_t id, uint16_t address, uint16_t *data, uint8_t *error = 0)
+  {
+    PortHandler   *port = port_;
+    PacketHandler *ph   = ph_;
+    return Transfer(reactor_, port_,
+                    [=]() { return waitStatus(ph->readTx(port, id, address, 2)); },
+                    [=, data_read = std::array<uint8_t, 2>()]() mutable
+                    {
+                      int result = ph->pollReadRx(port, id, 2, data_read.data(), error);
+                      if (result == COMM_SUCCESS)
+                        *data = DXL_MAKEWORD(data_read[0], data_read[1]);
+                      return result;
+                    });
+  }
+
+  Transfer read4ByteTxRx(uint8_t id, uint16_t address, uint32_t *data, uint8_t *error = 0)
+  {
+    PortHandler   *port = port_;
+    PacketHandler *ph   = ph_;
+    return Transfer(reactor_, port_,
+                    [=]() { return waitStatus(ph->readTx(port, id, address, 4)); },
+                    [=, data_read = std::array<uint8_t, 4>()]() mutable
+                    {
+                      int result = ph->pollReadRx(port, id, 4, data_read.data(), error);
+                      if (result == COMM_SUCCESS)
+                        *data = DXL_MAKEDWORD(DXL_MAKEWORD(data_read[0], data_read[1]), DXL_MAKEWORD(data_read[2], data_read[3]));
+                      return result;
+                    });
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that write by PacketHandler::writeTx() and receive the status packet by PacketHandler::pollReadRx()
+  /// @description The data is copied, so the caller may change its buffer at once. A write to BROADCAST_ID is sent by PacketHandler::writeTxOnly(), and ends when it is sent.
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param length Length of the data for write
+  /// @param data Data for write
+  /// @param error Buffer for Dynamixel hardware error, or 0
+  /// @return Transfer of the communication result
+  ////////////////////////////////////////////////////////////////////////////////
+  Transfer writeTxRx(uint8_t id, uint16_t address, uint16_t length, const uint8_t *data, uint8_t *error = 0)
+  {
+    PortHandler   *port = port_;
+    PacketHandler *ph   = ph_;
+    return Transfer(reactor_, port_,
+                    [=, buffer = std::vector<uint8_t>(data, data + length)]() mutable
+                    {
+                      if (id == BROADCAST_ID)
+                        return ph->writeTxOnly(port, id, address, length, buffer.data());
+
+                      // the port is kept from the instruction packet to the status packet
+                      return waitStatus(ph->writeTx(port, id, address, length, buffer.data()));
+                    },
+                    [=]() { return ph->pollReadRx(port, id, 0, 0, error); });
+  }
+
+  Transfer write1ByteTxRx(uint8_t id, uint16_t address, uint8_t data, uint8_t *error = 0)
+  {
+    uint8_t data_write[1] = { data };
+    return writeTxRx(id, address, 1, data_write, error);
+  }
+
+  Transfer write2ByteTxRx(uint8_t id, uint16_t address, uint16_t data, uint8_t *error = 0)
+  {
+    uint8_t data_write[2] = { DXL_LOBYTE(data), DXL_HIBYTE(data) };
+    return writeTxRx(id, address, 2, data_write, error);
+  }
+
+  Transfer write4ByteTxRx(uint8_t id, uint16_t address, uint32_t data, uint8_t *error = 0)
+  {
+    uint8_t data_write[4] = { DXL_LOBYTE(DXL_LOWORD(data)), DXL_HIBYTE(DXL_LOWORD(data)), DXL_LOBYTE(DXL_HIWORD(data)), DXL_HIBYTE(DXL_HIWORD(data)) };
+    return writeTxRx(id, address, 4, data_write, error);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that run the txPacket() and pollRx() of GroupSyncRead, GroupBulkRead and GroupIndirectSyncRead
+  /// @description The transfer runs on the port of the Group instance.
+  /// @param group Group instance
+  /// @return Transfer of the communication result
+  ////////////////////////////////////////////////////////////////////////////////
+  Transfer txRxPacket(GroupSyncRead &group)
+  {
+    GroupSyncRead *g = &group;
+    return Transfer(reactor_, g->getPortHandler(), [=]() { return waitStatus(g->txPacket()); }, [=]() { return g->pollRx(); });
+  }
+
+  Transfer txRxPacket(GroupBulkRead &group)
+  {
+    GroupBulkRead *g = &group;
+    return Transfer(reactor_, g->getPortHandler(), [=]() { return waitStatus(g->txPacket()); }, [=]() { return g->pollRx(); });
+  }
+
+  Transfer txRxPacket(GroupIndirectSyncRead &group)
+  {
+    GroupIndirectSyncRead *g = &group;
+    return Transfer(reactor_, g->getPortHandler(), [=]() { return waitStatus(g->txPacket()); }, [=]() { return g->pollRx(); });
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that run the txPacket() of GroupSyncWrite and GroupBulkWrite, which end when the packet is sent
+  /// @param group Group instance
+  /// @return Transfer of the communication result
+  ////////////////////////////////////////////////////////////////////////////////
+  Transfer txPacket(GroupSyncWrite &group)
+  {
+    GroupSyncWrite *g = &group;
+    return Transfer(reactor_, g->getPortHandler(), [=]() { return g->txPacket(); });
+  }
+
+  Transfer txPacket(GroupBulkWrite &group)
+  {
+    GroupBulkWrite *g = &group;
+    return Transfer(reactor_, g->getPortHandler(), [=]() { return g->txPacket(); });
+  }
+};
+
+}
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_COROUTINEHANDLER_H_ */
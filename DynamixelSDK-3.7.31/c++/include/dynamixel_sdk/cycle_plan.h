@@ -0,0 +1,238 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for turning the reads and writes of a control cycle into the fewest packets
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CYCLEPLAN_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CYCLEPLAN_H_
+
+
+#include <vector>
+#include "port_handler.h"
+#include "packet_handler.h"
+#include "group_sync_read.h"
+#include "group_sync_write.h"
+#include "group_bulk_read.h"
+#include "group_bulk_write.h"
+#include "group_indirect_sync_read.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that reads and writes the registers declared for each Dynamixel once per control cycle with the fewest packets
+/// @description CyclePlan::compile() chooses between Sync Read, Bulk Read, their Fast versions and Indirect Sync Read for the reads,
+/// @description and between Sync Write and Bulk Write for the writes, by the time they take on the wire at the baudrate of the port.
+/// @description With Protocol 1.0, the reads are sent to each Dynamixel and the writes are Sync Writes.
+/// @description CyclePlan::txRxPacket() sends the writes, then the reads, of one cycle.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC CyclePlan
+{
+ private:
+  struct Register
+  {
+    uint8_t   id;
+    uint16_t  address;
+    uint16_t  length;
+  };
+
+  struct Span
+  {
+    uint8_t   id;
+    uint16_t  address;
+    uint16_t  length;
+    uint8_t   error;
+    std::vector<uint8_t> data;
+  };
+
+  struct WriteGroup
+  {
+    GroupSyncWrite   *sync_write;
+    GroupBulkWrite   *bulk_write;
+    std::vector<int>  span_list;    // indexes in write_span_list_
+  };
+
+  enum ReadType { READ_NONE, READ_SYNC, READ_BULK, READ_INDIRECT, READ_EACH };
+
+  PortHandler    *port_;
+  PacketHandler  *ph_;
+
+  std::vector<Register>   read_list_;
+  std::vector<Register>   write_list_;
+
+  bool            last_result_;
+  bool            is_param_changed_;
+  bool            is_fast_read_;
+  bool            is_indirect_;
+  uint16_t        indirect_address_;
+  uint16_t        indirect_data_;
+  uint16_t        indirect_length_;
+  double          return_delay_time_;   // usec
+  double          cycle_time_;          // msec
+
+  ReadType                read_type_;
+  GroupSyncRead          *group_sync_read_;
+  GroupBulkRead          *group_bulk_read_;
+  GroupIndirectSyncRead  *group_indirect_sync_read_;
+  std::vector<Span>       read_span_list_;    // one for each ID
+  std::vector<Span>       write_span_list_;
+  std::vector<WriteGroup> write_group_list_;
+
+  void    releaseGroups();
+  double  getWireTime(int bytes, int status_packets);
+  int     planReads();
+  void    planWrites();
+  Span   *findSpan(std::vector<Span> &span_list, uint8_t id, uint16_t address, uint16_t data_length);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of CyclePlan
+  /// @param port PortHandler instance
+  /// @param ph PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  CyclePlan(PortHandler *port, PacketHandler *ph);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the plan
+  ////////////////////////////////////////////////////////////////////////////////
+  ~CyclePlan();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets whether the Dynamixels support Fast Sync Read and Fast Bulk Read
+  /// @param fast_read true to allow the Fast instructions
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setFastRead (bool fast_read) { is_fast_read_ = fast_read; is_param_changed_ = true; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that allows the reads to be packed into the indirect data by GroupIndirectSyncRead
+  /// @description The indirect addresses are programmed by CyclePlan::compile(), while the torque should be disabled.
+  /// @param indirect_address Address of Indirect Address 1
+  /// @param indirect_data Address of Indirect Data 1
+  /// @param max_length Number of the indirect addresses which may be used, or 0 not to use them
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setIndirectAddress(uint16_t indirect_address, uint16_t indirect_data, uint16_t max_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the return delay time of the Dynamixels for the estimated cycle time
+  /// @param return_delay_time Return delay time in usec (default 500)
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setReturnDelayTime(double return_delay_time) { return_delay_time_ = return_delay_time; is_param_changed_ = true; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a register which is read every cycle
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for read
+  /// @param data_length Length of the data for read
+  /// @return false
+  /// @return   when the ID is BROADCAST_ID or the length is 0
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    addRead     (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a register which is written every cycle
+  /// @description The value is set by CyclePlan::setData(), and is 0 until then.
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param data_length Length of the data for write
+  /// @return false
+  /// @return   when the ID is BROADCAST_ID or the length is 0
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    addWrite    (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the reads and writes of the plan
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearParam  ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that chooses the instructions of the cycle
+  /// @description The function is called by CyclePlan::txRxPacket() when the plan was changed.
+  /// @description When a Dynamixel answers the indirect addresses with an error, Sync Read or Bulk Read is chosen instead of Indirect Sync Read.
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when there are no reads and writes
+  /// @return COMM_SUCCESS
+  /// @return   when the plan is ready
+  /// @return or the communication results which come from GroupIndirectSyncRead::writeIndirectAddress
+  ////////////////////////////////////////////////////////////////////////////////
+  int     compile     ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the estimated time of a cycle planned by CyclePlan::compile()
+  /// @description The time is of the bytes on the wire at the baudrate of the port and the return delay time of each status packet.
+  /// @description The latency of the host and the USB adapter is not included.
+  /// @return Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getCycleTime() { return cycle_time_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the value of a register to be written in the next cycles
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param data_length Length of the data for write (1, 2 or 4)
+  /// @param data Data for write
+  /// @return false
+  /// @return   when the data is not within a register added by CyclePlan::addWrite
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    setData     (uint8_t id, uint16_t address, uint16_t data_length, uint32_t data);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that runs one cycle: the writes, then the reads
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when there are no reads and writes
+  /// @return or the first communication result which is not COMM_SUCCESS
+  ////////////////////////////////////////////////////////////////////////////////
+  int     txRxPacket  ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether there are available data which might be received by CyclePlan::txRxPacket
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for read
+  /// @param data_length Length of the data for read
+  /// @return false
+  /// @return   when there are no data available
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool        isAvailable (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the data which might be received by CyclePlan::txRxPacket
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for read
+  /// @param data_length Length of the data for read
+  /// @return data value
+  ////////////////////////////////////////////////////////////////////////////////
+  uint32_t    getData     (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the error which might be received by CyclePlan::txRxPacket
+  /// @param id Dynamixel ID
+  /// @param error error of Dynamixel
+  /// @return true
+  /// @return   when Dynamixel returned specific error byte
+  /// @return or false
+  ////////////////////////////////////////////////////////////////////////////////
+  bool        getError    (uint8_t id, uint8_t* error);
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_CYCLEPLAN_H_ */
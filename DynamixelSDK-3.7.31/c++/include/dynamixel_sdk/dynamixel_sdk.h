@@ -27,6 +27,15 @@
 #include "group_bulk_write.h"
 #include "group_sync_read.h"
 #include "group_sync_write.h"
+#include "response_time_estimator.h"
+#include "bus_scanner.h"
+#include "register_cache.h"
+#include "group_indirect_sync_read.h"
+#include "cycle_plan.h"
+#include "control_loop.h"
+#include "transaction_queue.h"
+#include "async_handler.h"
+#include "multi_bus_executor.h"
 #include "../dynamixel_sdk/packet_handler.h"
 #include "port_handler.h"
 
@@ -23,7 +23,6 @@
 #define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_GROUPBULKREAD_H_
 
 
-#include <map>
 #include <vector>
 #include "port_handler.h"
 #include "packet_handler.h"
@@ -41,13 +40,16 @@ class WINDECLSPEC GroupBulkRead
   PacketHandler  *ph_;
 
   std::vector<uint8_t>            id_list_;
-  std::map<uint8_t, uint16_t>     address_list_;  // <id, start_address>
-  std::map<uint8_t, uint16_t>     length_list_;   // <id, data_length>
-  std::map<uint8_t, uint8_t *>    data_list_;     // <id, data>
-  std::map<uint8_t, uint8_t *>    error_list_;    // <id, error>
+  int16_t                         slot_list_[256];  // <id, index in id_list_>, -1 when the id is not in the list
+  std::vector<uint16_t>           address_list_;    // start_address of each index in id_list_
+  std::vector<uint16_t>           length_list_;     // data_length of each index in id_list_
+  std::vector<uint16_t>           offset_list_;     // position in data_list_ of each index in id_list_
+  std::vector<uint8_t>            data_list_;       // [ERROR ID DATA... CRC16_L CRC16_H] of each id, as in the status packet of Fast Bulk Read
 
   bool            last_result_;
   bool            is_param_changed_;
+  bool            is_fast_read_;
+  int             rx_index_;        // index in id_list_ of the status packet being received, kept between the calls of GroupBulkRead::pollRx()
 
   uint8_t        *param_;
 
@@ -78,6 +80,20 @@ class WINDECLSPEC GroupBulkRead
   ////////////////////////////////////////////////////////////////////////////////
   PacketHandler   *getPacketHandler() { return ph_; }
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets whether Fast Bulk Read is used
+  /// @description With Fast Bulk Read, all Dynamixels in the list answer in one status packet instead of one packet for each.
+  /// @description The firmware of the Dynamixels should support INST_FAST_BULK_READ.
+  /// @param fast_read true to use Fast Bulk Read, or false to use Bulk Read
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setFastRead (bool fast_read) { is_fast_read_ = fast_read; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns whether Fast Bulk Read is used
+  /// @return true when Fast Bulk Read is used
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isFastRead  () { return is_fast_read_; }
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that adds id, start_address, data_length to the Bulk Read list
   /// @param id Dynamixel ID
@@ -104,7 +120,7 @@ class WINDECLSPEC GroupBulkRead
   /// @brief The function that transmits the Bulk Read instruction packet which might be constructed by GroupBulkRead::addParam function
   /// @return COMM_NOT_AVAILABLE
   /// @return   when the list for Bulk Read is empty
-  /// @return or the other communication results which come from PacketHandler::bulkReadTx
+  /// @return or the other communication results which come from PacketHandler::bulkReadTx or PacketHandler::fastBulkReadTx
   ////////////////////////////////////////////////////////////////////////////////
   int     txPacket();
 
@@ -120,6 +136,22 @@ class WINDECLSPEC GroupBulkRead
   ////////////////////////////////////////////////////////////////////////////////
   int     rxPacket();
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives the packets which might be come from the Dynamixels, without waiting
+  /// @description The function takes the bytes available on the port and returns at once, so the caller can do other work between the calls.
+  /// @description The next call goes on from the packets already received, until all IDs in the list are in or the packet timeout passes.
+  /// @description The port stays in use until the function returns other than COMM_RX_WAITING.
+  /// @description GroupBulkRead::rxPacket() calls the function until it returns other than COMM_RX_WAITING.
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list for Bulk Read is empty
+  /// @return COMM_RX_WAITING
+  /// @return   when some of the packets are not received yet
+  /// @return COMM_SUCCESS
+  /// @return   when the packets of all IDs in the list are received
+  /// @return or the other communication results
+  ////////////////////////////////////////////////////////////////////////////////
+  int     pollRx();
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits and receives the packet which might be come from the Dynamixel
   /// @return COMM_RX_FAIL
@@ -0,0 +1,213 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for reading scattered registers of multiple Dynamixels at once through the indirect addresses
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_GROUPINDIRECTSYNCREAD_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_GROUPINDIRECTSYNCREAD_H_
+
+
+#include <vector>
+#include "port_handler.h"
+#include "packet_handler.h"
+#include "group_sync_read.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class for reading registers at any addresses of multiple Dynamixels with one Sync Read
+/// @description The registers of each Dynamixel are packed one after another into its indirect data.
+/// @description GroupIndirectSyncRead::writeIndirectAddress() programs the indirect addresses once,
+/// @description then each GroupIndirectSyncRead::txRxPacket() reads all the registers of all Dynamixels in one transaction,
+/// @description and GroupIndirectSyncRead::getData() takes the original addresses.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC GroupIndirectSyncRead
+{
+ private:
+  struct Register
+  {
+    uint16_t  address;
+    uint16_t  length;
+    uint16_t  offset;   // in the indirect data
+  };
+
+  PortHandler    *port_;
+  PacketHandler  *ph_;
+
+  std::vector<uint8_t>  id_list_;
+  std::vector<Register> register_list_[BROADCAST_ID];   // [id]
+  uint16_t              data_length_[BROADCAST_ID];     // [id]
+
+  GroupSyncRead  *group_sync_read_;
+
+  bool            is_param_changed_;
+  bool            is_fast_read_;
+
+  uint16_t        indirect_address_;
+  uint16_t        indirect_data_;
+  uint16_t        max_length_;
+
+  void    makeGroupSyncRead();
+  const Register *findRegister(uint8_t id, uint16_t address, uint16_t data_length);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that Initializes instance for Indirect Sync Read
+  /// @description The addresses are different in Dynamixel model (for example, X series: 168, 224 and 28 / PRO: 49, 634 and 256)
+  /// @param port PortHandler instance
+  /// @param ph PacketHandler instance
+  /// @param indirect_address Address of Indirect Address 1
+  /// @param indirect_data Address of Indirect Data 1
+  /// @param max_length Number of the indirect addresses which may be used
+  ////////////////////////////////////////////////////////////////////////////////
+  GroupIndirectSyncRead(PortHandler *port, PacketHandler *ph, uint16_t indirect_address, uint16_t indirect_data, uint16_t max_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the list and releases the Sync Read
+  ////////////////////////////////////////////////////////////////////////////////
+  ~GroupIndirectSyncRead();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PortHandler instance
+  /// @return PortHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PortHandler     *getPortHandler()   { return port_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PacketHandler instance
+  /// @return PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PacketHandler   *getPacketHandler() { return ph_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets whether Fast Sync Read is used
+  /// @param fast_read true to use Fast Sync Read, or false to use Sync Read
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setFastRead (bool fast_read);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a register of a Dynamixel to the list
+  /// @description The register is placed after the registers added before for the ID.
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for read
+  /// @param data_length Length of the data for read
+  /// @return false
+  /// @return   when the register overlaps one which exists already in the list
+  /// @return   when the registers of the ID do not fit in the indirect addresses
+  /// @return   when the protocol1.0 has been used
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    addParam    (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that removes all registers of a Dynamixel from the list
+  /// @param id Dynamixel ID
+  ////////////////////////////////////////////////////////////////////////////////
+  void    removeParam (uint8_t id);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the list
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearParam  ();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that programs the indirect addresses of a Dynamixel for its registers in the list
+  /// @description The function reads the indirect addresses first, and writes them only when they are different.
+  /// @description The torque of the Dynamixel should be disabled, as the indirect addresses cannot be written while it is enabled.
+  /// @param id Dynamixel ID
+  /// @param error Dynamixel hardware error
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the ID is not in the list
+  /// @return   when the protocol1.0 has been used
+  /// @return or the other communication results which come from PacketHandler::readTxRx or PacketHandler::writeTxRx
+  ////////////////////////////////////////////////////////////////////////////////
+  int     writeIndirectAddress(uint8_t id, uint8_t *error = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits the Sync Read instruction packet of the indirect data
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is empty
+  /// @return   when the protocol1.0 has been used
+  /// @return or the other communication results which come from GroupSyncRead::txPacket
+  ////////////////////////////////////////////////////////////////////////////////
+  int     txPacket();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives the packet which might be come from the Dynamixel
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is empty
+  /// @return   when the protocol1.0 has been used
+  /// @return or the other communication results which come from GroupSyncRead::rxPacket
+  ////////////////////////////////////////////////////////////////////////////////
+  int     rxPacket();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives the packet which might be come from the Dynamixel, without waiting
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is empty
+  /// @return   when the protocol1.0 has been used
+  /// @return or the other communication results which come from GroupSyncRead::pollRx
+  ////////////////////////////////////////////////////////////////////////////////
+  int     pollRx();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits and receives the packet which might be come from the Dynamixel
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when the list is empty
+  /// @return   when the protocol1.0 has been used
+  /// @return or the other communication results which come from GroupIndirectSyncRead::txPacket or GroupIndirectSyncRead::rxPacket
+  ////////////////////////////////////////////////////////////////////////////////
+  int     txRxPacket();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether there are available data which might be received by GroupIndirectSyncRead::rxPacket or GroupIndirectSyncRead::txRxPacket
+  /// @param id Dynamixel ID
+  /// @param address Original address of the data for read
+  /// @param data_length Length of the data for read
+  /// @return false
+  /// @return   when there are no data available
+  /// @return   when the data is not within a register added for the ID
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool        isAvailable (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the data which might be received by GroupIndirectSyncRead::rxPacket or GroupIndirectSyncRead::txRxPacket
+  /// @param id Dynamixel ID
+  /// @param address Original address of the data for read
+  /// @param data_length Length of the data for read
+  /// @return data value
+  ////////////////////////////////////////////////////////////////////////////////
+  uint32_t    getData     (uint8_t id, uint16_t address, uint16_t data_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the error which might be received by GroupIndirectSyncRead::rxPacket or GroupIndirectSyncRead::txRxPacket
+  /// @param id Dynamixel ID
+  /// @param error error of Dynamixel
+  /// @return true
+  /// @return   when Dynamixel returned specific error byte
+  /// @return or false
+  ////////////////////////////////////////////////////////////////////////////////
+  bool        getError    (uint8_t id, uint8_t* error);
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_GROUPINDIRECTSYNCREAD_H_ */
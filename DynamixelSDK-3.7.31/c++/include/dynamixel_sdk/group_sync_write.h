@@ -46,6 +46,8 @@ class WINDECLSPEC GroupSyncWrite
   bool            is_param_changed_;
 
   uint8_t        *param_;
+  uint8_t        *packet_;          // instruction packet kept for the next txPacket()
+  uint16_t        packet_length_;   // 0 when packet_ is not ready to be transmitted
   uint16_t        start_address_;
   uint16_t        data_length_;
 
@@ -96,6 +98,7 @@ class WINDECLSPEC GroupSyncWrite
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that changes the data for write in id -> start_address -> data_length to the Sync Write list
+  /// @description The data is written in the instruction packet made already, with the checksum or CRC16 updated only for the data.
   /// @param id Dynamixel ID
   /// @param data for replacement
   /// @return false
@@ -111,9 +114,10 @@ class WINDECLSPEC GroupSyncWrite
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits the Sync Write instruction packet which might be constructed by GroupSyncWrite::addParam function
+  /// @description The packet is made again only when the list has been changed, and transmitted as it is otherwise.
   /// @return COMM_NOT_AVAILABLE
   /// @return   when the list for Sync Write is empty
-  /// @return or the other communication results which come from PacketHandler::syncWriteTxOnly
+  /// @return or the other communication results which come from PacketHandler::txSyncWritePacket or PacketHandler::syncWriteTxOnly
   ////////////////////////////////////////////////////////////////////////////////
   int     txPacket();
 };
@@ -0,0 +1,180 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for running the control cycles of several buses at the same time, each on its own thread
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_MULTIBUSEXECUTOR_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_MULTIBUSEXECUTOR_H_
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "cycle_plan.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that runs the CyclePlan of each bus on its own thread, and joins them at the end of each cycle
+/// @description The buses are independent serial links, so a cycle takes as long as the slowest bus instead of the sum of all.
+/// @description The threads sleep between the cycles, and may be pinned to CPUs so that the buses do not share one.
+/// @description MultiBusExecutor::txRxPacket() may be called by the callback of a ControlLoop without CyclePlan to run at a fixed rate.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC MultiBusExecutor
+{
+ private:
+  class Bus
+  {
+   public:
+    CyclePlan      *plan;
+    int             cpu;
+    std::thread     thread;
+
+    int             result;
+    double          cycle_time;       // msec
+    double          max_cycle_time;   // msec
+    double          sum_cycle_time;   // msec
+  };
+
+  std::vector<Bus *>        bus_list_;
+
+  std::mutex                mutex_;
+  std::condition_variable   start_condition_;
+  std::condition_variable   done_condition_;
+  unsigned long             generation_;      // counted up to start a cycle on all threads
+  int                       running_count_;   // threads which have not finished the cycle
+  bool                      is_running_;
+
+  unsigned long             cycle_count_;
+  double                    cycle_time_;      // msec
+  double                    max_cycle_time_;  // msec
+  double                    sum_cycle_time_;  // msec
+
+  void    process(Bus *bus);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of MultiBusExecutor
+  ////////////////////////////////////////////////////////////////////////////////
+  MultiBusExecutor();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that stops the threads
+  ////////////////////////////////////////////////////////////////////////////////
+  ~MultiBusExecutor();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds the CyclePlan of a bus
+  /// @description Each CyclePlan should have its own PortHandler.
+  /// @param plan CyclePlan instance
+  /// @param cpu CPU which the thread of the bus is pinned to, or -1 not to pin it (default)
+  /// @return -1
+  /// @return   when the threads are running
+  /// @return or index of the bus
+  ////////////////////////////////////////////////////////////////////////////////
+  int     addBus(CyclePlan *plan, int cpu = -1);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the number of the buses
+  /// @return Number of the buses
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getBusCount() { return (int)bus_list_.size(); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the CyclePlan of a bus
+  /// @param index Index of the bus
+  /// @return CyclePlan instance
+  ////////////////////////////////////////////////////////////////////////////////
+  CyclePlan *getCyclePlan(int index) { return bus_list_[index]->plan; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that starts a thread for each bus, and pins it to its CPU
+  /// @description MultiBusExecutor::txRxPacket() calls the function if the threads are not running.
+  /// @return false
+  /// @return   when there is no bus
+  /// @return   when the threads are already running
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    start();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that stops the threads after the cycle running
+  ////////////////////////////////////////////////////////////////////////////////
+  void    stop();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that runs CyclePlan::txRxPacket() of all buses at the same time, and waits until all of them end
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when there is no bus
+  /// @return   when MultiBusExecutor::stop() is called by another thread before the cycle starts on a bus
+  /// @return COMM_SUCCESS
+  /// @return   when all buses succeeded
+  /// @return or the communication result of the first bus which failed
+  ////////////////////////////////////////////////////////////////////////////////
+  int     txRxPacket();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the estimated time of a cycle, which is the longest of CyclePlan::getCycleTime()
+  /// @return Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getEstimatedCycleTime();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the communication result of a bus in the last cycle
+  /// @param index Index of the bus
+  /// @return Communication result which comes from CyclePlan::txRxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getResult(int index) { return bus_list_[index]->result; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that return the last, the longest and the average time of CyclePlan::txRxPacket() of a bus
+  /// @param index Index of the bus
+  /// @return Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getBusCycleTime(int index)        { return bus_list_[index]->cycle_time; }
+  double  getMaxBusCycleTime(int index)     { return bus_list_[index]->max_cycle_time; }
+  double  getAverageBusCycleTime(int index) { return (cycle_count_ > 0) ? bus_list_[index]->sum_cycle_time / cycle_count_ : 0.0; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that return the last, the longest and the average time of MultiBusExecutor::txRxPacket(), which includes waking and joining the threads
+  /// @return Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getCycleTime()        { return cycle_time_; }
+  double  getMaxCycleTime()     { return max_cycle_time_; }
+  double  getAverageCycleTime() { return (cycle_count_ > 0) ? sum_cycle_time_ / cycle_count_ : 0.0; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the number of the cycles run since the statistics were cleared
+  /// @return Number of the cycles
+  ////////////////////////////////////////////////////////////////////////////////
+  unsigned long getCycleCount() { return cycle_count_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears the cycle times
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearStatistics();
+};
+
+}
+
+#endif
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_MULTIBUSEXECUTOR_H_ */
@@ -61,6 +61,8 @@
 #define INST_STATUS             85      // 0x55
 #define INST_SYNC_READ          130     // 0x82
 #define INST_BULK_WRITE         147     // 0x93
+#define INST_FAST_SYNC_READ     138     // 0x8A
+#define INST_FAST_BULK_READ     154     // 0x9A
 
 // Communication Result
 #define COMM_SUCCESS        0       // tx or rx packet communication success
@@ -132,7 +134,9 @@ class WINDECLSPEC PacketHandler
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that receives packet (rxpacket) during designated time via PortHandler port
-  /// @description The function repeatedly tries to receive rxpacket by PortHandler::readPort() function.
+  /// @description The function repeatedly tries to receive rxpacket by PortHandler::fillRxBuffer() function,
+  /// @description waiting for the next bytes by PortHandler::waitForBytes() function.
+  /// @description The bytes following rxpacket are left in the receive buffer of the port for the next call.
   /// @description It breaks out
   /// @description when PortHandler::isPacketTimeout() shows the timeout,
   /// @description when rxpacket seemed as corrupted, or
@@ -151,6 +155,19 @@ class WINDECLSPEC PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   virtual int rxPacket        (PortHandler *port, uint8_t *rxpacket) = 0;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives packet (rxpacket) from the bytes available now, without waiting
+  /// @description The function takes the bytes available by PortHandler::fillRxBuffer() function, and returns at once.
+  /// @description The bytes of a packet not complete yet stay in the receive buffer of the port, and the next call goes on with them.
+  /// @description The port stays in use until the function returns other than COMM_RX_WAITING, or after a Sync Read or a Bulk Read until the last status packet has come.
+  /// @param port PortHandler instance
+  /// @param rxpacket received packet
+  /// @return COMM_RX_WAITING
+  /// @return   when rxpacket is not complete and PortHandler::isPacketTimeout() doesn't show the timeout yet
+  /// @return or the other communication results as PacketHandler::rxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int pollRxPacket    (PortHandler *port, uint8_t *rxpacket) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits packet (txpacket) and receives packet (rxpacket) during designated time via PortHandler port
   /// @description The function calls PacketHandler::txPacket(),
@@ -196,6 +213,21 @@ class WINDECLSPEC PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   virtual int ping            (PortHandler *port, uint8_t id, uint16_t *model_number, uint8_t *error = 0) = 0;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_PING instruction packet
+  /// @description The function makes an instruction packet with INST_PING,
+  /// @description transmits the packet with PacketHandler::txPacket(),
+  /// @description and sets the packet timeout for the status packet, which is received by PacketHandler::readRx() or PacketHandler::pollReadRx().
+  /// @description It breaks out
+  /// @description when it tries to transmit to BROADCAST_ID
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when it tries to transmit to BROADCAST_ID
+  /// @return or the other communication results which come from PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int pingTx          (PortHandler *port, uint8_t id) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief (Available only in Protocol 2.0) The function that pings all connected Dynamixel
   /// @param port PortHandler instance
@@ -204,6 +236,21 @@ class WINDECLSPEC PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   virtual int broadcastPing   (PortHandler *port, std::vector<uint8_t> &id_list) = 0;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief (Available only in Protocol 2.0) The function that pings all connected Dynamixel and stops when the bus goes quiet
+  /// @description The function parses the status packets as they arrive.
+  /// @description It stops when no byte came for idle_time after the last byte (or the transmission),
+  /// @description when expected_count Dynamixels are found, or after the time PacketHandler::broadcastPing() waits.
+  /// @description Dynamixels answer in the order of their ID, so idle_time should cover the gap of the unused IDs
+  /// @description and the latency timer of the USB serial converter.
+  /// @param port PortHandler instance
+  /// @param id_list ID list of Dynamixels which are found by broadcast ping
+  /// @param idle_time Time in msec to wait for the next byte, or 0 to wait for all IDs
+  /// @param expected_count Number of Dynamixels to stop at, or 0 not to stop by the count
+  /// @return COMM_NOT_AVAILABLE
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int broadcastPing   (PortHandler *port, std::vector<uint8_t> &id_list, double idle_time, int expected_count = 0) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that makes Dynamixels run as written in the Dynamixel register
   /// @description The function makes an instruction packet with INST_ACTION,
@@ -282,6 +329,17 @@ class WINDECLSPEC PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   virtual int readRx          (PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error = 0) = 0;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads the data in the packet as PacketHandler::readRx(), without waiting
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @param length Length of the data for read
+  /// @param data Data extracted from the packet
+  /// @param error Dynamixel hardware error
+  /// @return communication results which come from PacketHandler::pollRxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int pollReadRx      (PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error = 0) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_READ instruction packet, and read data from received packet
   /// @description The function makes an instruction packet with INST_READ,
@@ -419,6 +477,24 @@ class WINDECLSPEC PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   virtual int writeTxOnly     (PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data) = 0;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_WRITE instruction packet with the data for write, and keeps the port for the status packet
+  /// @description The function makes an instruction packet with INST_WRITE and the data for write,
+  /// @description transmits the packet with PacketHandler::txPacket().
+  /// @description The port stays in use until the status packet is received by PacketHandler::pollReadRx() or PacketHandler::readRx() with length 0.
+  /// @description It breaks out
+  /// @description when it tries to transmit to BROADCAST_ID
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param length Length of the data for write
+  /// @param data Data for write
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when it tries to transmit to BROADCAST_ID
+  /// @return or the other communication results which come from PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int writeTx         (PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_WRITE instruction packet with the data for write, and receives the packet
   /// @description The function makes an instruction packet with INST_WRITE and the data for write,
@@ -551,6 +627,45 @@ class WINDECLSPEC PacketHandler
   // SyncReadRx   -> GroupSyncRead class
   // SyncReadTxRx -> GroupSyncRead class
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_FAST_SYNC_READ instruction packet
+  /// @description The function makes an instruction packet with INST_FAST_SYNC_READ,
+  /// @description transmits the packet with PacketHandler::txPacket().
+  /// @description All Dynamixels in the parameter answer in one status packet, which is received by PacketHandler::fastReadRx().
+  /// @param port PortHandler instance
+  /// @param start_address Address of the data for Fast Sync Read
+  /// @param data_length Length of the data for Fast Sync Read
+  /// @param param Parameter for Fast Sync Read
+  /// @param param_length Length of the data for Fast Sync Read
+  /// @return communication results which come from PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int fastSyncReadTx  (PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length) = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives the status packet of Fast Sync Read or Fast Bulk Read and reads the parameter in the packet
+  /// @description The function receives the status packet sent with BROADCAST_ID by the Dynamixels,
+  /// @description and gets the parameter {ERROR1, ID1, DATA1..., CRC16_L1, CRC16_H1, ERROR2, ID2, DATA2..., ...} from the packet.
+  /// @description The last Dynamixel has no CRC16 in the parameter, as the CRC16 of the packet follows.
+  /// @param port PortHandler instance
+  /// @param length Length of the parameter for read
+  /// @param param Parameter extracted from the packet
+  /// @return COMM_RX_CORRUPT
+  /// @return   when the length of the parameter differs from length
+  /// @return or the other communication results which come from PacketHandler::rxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int fastReadRx      (PortHandler *port, uint16_t length, uint8_t *param) = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads the parameter in the packet as PacketHandler::fastReadRx(), without waiting
+  /// @param port PortHandler instance
+  /// @param length Length of the parameter for read
+  /// @param param Parameter extracted from the packet
+  /// @return COMM_RX_CORRUPT
+  /// @return   when the length of the parameter differs from length
+  /// @return or the other communication results which come from PacketHandler::pollRxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int pollFastReadRx  (PortHandler *port, uint16_t length, uint8_t *param) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_SYNC_WRITE instruction packet
   /// @description The function makes an instruction packet with INST_SYNC_WRITE,
@@ -564,6 +679,47 @@ class WINDECLSPEC PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   virtual int syncWriteTxOnly (PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length) = 0;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes INST_SYNC_WRITE instruction packet to be transmitted repeatedly
+  /// @description The function makes a complete instruction packet with INST_SYNC_WRITE in txpacket,
+  /// @description which can be updated by PacketHandler::updateSyncWritePacket() and transmitted by PacketHandler::txSyncWritePacket().
+  /// @param txpacket Buffer of param_length + 14 bytes at least
+  /// @param start_address Address of the data for Sync Write
+  /// @param data_length Length of the data for Sync Write
+  /// @param param Parameter for Sync Write
+  /// @param param_length Length of the data for Sync Write
+  /// @return 0
+  /// @return   when the packet is too long or needs byte stuffing, then PacketHandler::syncWriteTxOnly() should be used
+  /// @return or length of the packet
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual uint16_t makeSyncWritePacket(uint8_t *txpacket, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length) = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that changes a part of the parameter in the packet made by PacketHandler::makeSyncWritePacket()
+  /// @description The function writes data in the packet, and updates the checksum or CRC16 only with the changed bytes.
+  /// @param txpacket Packet made by PacketHandler::makeSyncWritePacket()
+  /// @param param_index Index of the data in the parameter for Sync Write
+  /// @param data Data for write
+  /// @param length Length of the data
+  /// @return false
+  /// @return   when the packet needs byte stuffing with the data, then it should be made again
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual bool updateSyncWritePacket(uint8_t *txpacket, uint16_t param_index, uint8_t *data, uint16_t length) = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits the packet made by PacketHandler::makeSyncWritePacket()
+  /// @description The function clears the port and writes the packet as it is.
+  /// @param port PortHandler instance
+  /// @param txpacket Packet made by PacketHandler::makeSyncWritePacket()
+  /// @return COMM_PORT_BUSY
+  /// @return   when the port is already in use
+  /// @return COMM_TX_FAIL
+  /// @return   when it failed to write the packet
+  /// @return or COMM_SUCCESS
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int txSyncWritePacket(PortHandler *port, uint8_t *txpacket) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_BULK_READ instruction packet
   /// @description The function makes an instruction packet with INST_BULK_READ,
@@ -577,6 +733,18 @@ class WINDECLSPEC PacketHandler
   // BulkReadRx   -> GroupBulkRead class
   // BulkReadTxRx -> GroupBulkRead class
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_FAST_BULK_READ instruction packet
+  /// @description The function makes an instruction packet with INST_FAST_BULK_READ,
+  /// @description transmits the packet with PacketHandler::txPacket().
+  /// @description All Dynamixels in the parameter answer in one status packet, which is received by PacketHandler::fastReadRx().
+  /// @param port PortHandler instance
+  /// @param param Parameter for Fast Bulk Read
+  /// @param param_length Length of the data for Fast Bulk Read
+  /// @return communication results which come from PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual int fastBulkReadTx  (PortHandler *port, uint8_t *param, uint16_t param_length) = 0;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_BULK_WRITE instruction packet
   /// @description The function makes an instruction packet with INST_BULK_WRITE,
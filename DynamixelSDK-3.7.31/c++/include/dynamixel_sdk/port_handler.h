@@ -46,15 +46,49 @@
 #endif
 
 #include <stdint.h>
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+#include <mutex>
+#endif
+
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#define RX_BUFFER_SIZE      256   // size of the receive buffer of each port (power of 2, not less than PACKET_BUFFER_SIZE)
+#define PACKET_BUFFER_SIZE  256   // the longest packet of Protocol 1.0, and of Protocol 2.0 on the boards with little RAM
+#else
+#define RX_BUFFER_SIZE      4096  // size of the receive buffer of each port (power of 2, not less than PACKET_BUFFER_SIZE)
+#define PACKET_BUFFER_SIZE  (1024 + (1024 / 3) + 16)  // the longest packet of Protocol 2.0 with the room for byte stuffing
+#endif
 
 namespace dynamixel
 {
 
+class ResponseTimeEstimator;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief The class for port control that inherits PortHandlerLinux, PortHandlerWindows, PortHandlerMac, or PortHandlerArduino
 ////////////////////////////////////////////////////////////////////////////////
 class WINDECLSPEC PortHandler
 {
+ private:
+  ResponseTimeEstimator  *response_time_estimator_;
+  uint8_t                 response_id_;
+  uint8_t                 response_instruction_;
+  bool                    is_response_pending_;   // set by PortHandler::setResponseTimeout() until the response or its timeout is added
+
+  double  getTxTimePerByte();
+
+  uint8_t   rx_buffer_[RX_BUFFER_SIZE];   // ring buffer of the bytes read from the port
+  uint32_t  rx_buffer_head_;              // total number of bytes put in the buffer
+  uint32_t  rx_buffer_tail_;              // total number of bytes taken from the buffer
+
+  uint8_t   rx_packet_buffer_[PACKET_BUFFER_SIZE];  // status packet being received
+  uint16_t  status_packet_count_;                   // status packets to be received before the port is released
+
+  bool      is_port_error_;                         // set by PortHandler::waitForBytes() when the port has failed
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+  std::recursive_mutex port_mutex_;       // owner of the port over several transactions
+#endif
+
  public:
   static const int DEFAULT_BAUDRATE_ = 57600; ///< Default Baudrate
 
@@ -64,7 +98,9 @@ class WINDECLSPEC PortHandler
   ////////////////////////////////////////////////////////////////////////////////
   static PortHandler *getPortHandler(const char *port_name);
 
-  bool   is_using_; ///< shows whether the port is in use
+  bool   is_using_; ///< shows whether the port is in use, changed by PortHandler::setUsing() and PortHandler::clearUsing()
+
+  PortHandler() : response_time_estimator_(0), response_id_(0), response_instruction_(0), is_response_pending_(false), rx_buffer_head_(0), rx_buffer_tail_(0), status_packet_count_(0), is_port_error_(false) { }
 
   virtual ~PortHandler() { }
 
@@ -83,7 +119,7 @@ class WINDECLSPEC PortHandler
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that clears the port
-  /// @description The function clears the port.
+  /// @description The function clears the port and the receive buffer.
   ////////////////////////////////////////////////////////////////////////////////
   virtual void    clearPort() = 0;
 
@@ -150,6 +186,122 @@ class WINDECLSPEC PortHandler
   ////////////////////////////////////////////////////////////////////////////////
   virtual int     writePort(uint8_t *packet, int length) = 0;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads all the bytes available on the port into the receive buffer
+  /// @description The function calls PortHandler::readPort() with all the free space of the receive buffer,
+  /// @description so that the bytes available are taken by a single read in most cases.
+  /// @return Number of bytes read
+  ////////////////////////////////////////////////////////////////////////////////
+  int     fillRxBuffer();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the number of bytes in the receive buffer
+  /// @return Length of the bytes in the receive buffer
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getRxBufferLength() { return (int)(rx_buffer_head_ - rx_buffer_tail_); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns a byte in the receive buffer without taking it
+  /// @param offset Offset from the oldest byte in the receive buffer (less than PortHandler::getRxBufferLength())
+  /// @return The byte at the offset
+  ////////////////////////////////////////////////////////////////////////////////
+  uint8_t peekRxBuffer(int offset) { return rx_buffer_[(rx_buffer_tail_ + offset) & (RX_BUFFER_SIZE - 1)]; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that takes bytes from the receive buffer
+  /// @param packet Buffer for the bytes taken
+  /// @param length Length of the bytes to take
+  /// @return Length of the bytes taken
+  ////////////////////////////////////////////////////////////////////////////////
+  int     popRxBuffer(uint8_t *packet, int length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that discards bytes in the receive buffer
+  /// @param length Length of the bytes to discard
+  ////////////////////////////////////////////////////////////////////////////////
+  void    skipRxBuffer(int length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that discards all the bytes in the receive buffer
+  /// @description The function is called by PortHandler::clearPort(), and also clears the error shown by PortHandler::isPortError().
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearRxBuffer() { rx_buffer_tail_ = rx_buffer_head_; is_port_error_ = false; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that marks that the port has failed, such as an adapter unplugged
+  /// @description The function is called by PortHandler::waitForBytes(). No more bytes are expected until PortHandler::clearPort().
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setPortError() { is_port_error_ = true; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether the port has failed since PortHandler::clearPort()
+  /// @description The packet handlers end the receive with COMM_RX_FAIL instead of polling the port until the timeout.
+  /// @return true when the port has failed
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isPortError() { return is_port_error_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the buffer for the status packet received on the port
+  /// @description The packet handlers receive the status packet in this buffer instead of allocating one in every transaction.
+  /// @description The buffer is used only while the port is in use, so the instruction packets are made on the stack of the sender instead.
+  /// @return Buffer of PACKET_BUFFER_SIZE bytes
+  ////////////////////////////////////////////////////////////////////////////////
+  uint8_t *getRxPacketBuffer() { return rx_packet_buffer_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that marks the port in use for a transaction
+  /// @description The packet handlers call the function before sending an instruction packet.
+  /// @description The test and the set of PortHandler::is_using_ are one atomic operation, so only one thread can get the port.
+  /// @description The transaction expects one status packet until PortHandler::setStatusPacketCount() is called.
+  /// @return false
+  /// @return   when the port is already in use
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    setUsing();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that marks the port not in use at the end of a transaction
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clearUsing();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the number of the status packets which the instruction sent on the port asks for
+  /// @description The packet handlers call the function after sending a Sync Read or a Bulk Read,
+  /// @description so that the port stays in use until the status packet of the last Dynamixel.
+  /// @param count Number of the status packets
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setStatusPacketCount(uint16_t count) { status_packet_count_ = count; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that ends the receive of a status packet
+  /// @description The function releases the port by PortHandler::clearUsing() when the receive failed or the last status packet has come.
+  /// @description The packet handlers call the function after they have taken the data out of the buffer of PortHandler::getRxPacketBuffer().
+  /// @param result Communication result of the receive, and the function does nothing with COMM_RX_WAITING
+  ////////////////////////////////////////////////////////////////////////////////
+  void    endStatusPacket(int result);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits until the calling thread owns the port
+  /// @description PortHandler::setUsing() covers one transaction, and a Sync Read or a TxRx of another thread may start between two of them.
+  /// @description The threads sharing the port hold it by this function over the transactions which should not be split.
+  /// @description The owner may lock the port again, and should call PortHandler::unlockPort() as many times.
+  /// @description The function does nothing on Arduino.
+  ////////////////////////////////////////////////////////////////////////////////
+  void    lockPort();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that owns the port when no other thread owns it
+  /// @return false
+  /// @return   when another thread owns the port
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    tryLockPort();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that releases the port locked by PortHandler::lockPort() or PortHandler::tryLockPort()
+  ////////////////////////////////////////////////////////////////////////////////
+  void    unlockPort();
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that sets and starts stopwatch for watching packet timeout
   /// @description The function sets the stopwatch by getting current time and the time of packet timeout with packet_length.
@@ -169,6 +321,68 @@ class WINDECLSPEC PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerLinux::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   virtual bool    isPacketTimeout() = 0;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits until bytes are able to be read from the port buffer
+  /// @description The function blocks the caller until the port buffer has bytes to read
+  /// @description or the time of packet timeout set by PortHandler::setPacketTimeout() is passed.
+  /// @description The default implementation only yields the processor once.
+  /// @return false
+  /// @return   when the packet timeout has passed without bytes to read
+  /// @return   when the port has failed, which PortHandler::isPortError() shows then
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual bool    waitForBytes();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the time passed since the packet timeout was set
+  /// @description The function returns the time passed since the last call of PortHandler::setPacketTimeout().
+  /// @return -1.0
+  /// @return   when the port handler doesn't measure it
+  /// @return or Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual double  getPacketElapsedTime() { return -1.0; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the estimator of the response time of Dynamixel on the port
+  /// @description When the estimator is set, the packet handlers measure the response time of every successful transaction
+  /// @description and take the packet timeout from the estimator instead of the packet length.
+  /// @param estimator ResponseTimeEstimator instance, or 0 to use the packet length only
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setResponseTimeEstimator(ResponseTimeEstimator *estimator) { response_time_estimator_ = estimator; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the estimator of the response time of Dynamixel on the port
+  /// @return ResponseTimeEstimator instance, or 0
+  ////////////////////////////////////////////////////////////////////////////////
+  ResponseTimeEstimator *getResponseTimeEstimator() { return response_time_estimator_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets and starts stopwatch for watching the response of Dynamixel
+  /// @description The function sets the packet timeout estimated by the ResponseTimeEstimator for the id and the instruction,
+  /// @description added to the time to transfer packet_length bytes at the baudrate.
+  /// @description Without the estimator, or before any response was measured, it calls PortHandler::setPacketTimeout() with packet_length.
+  /// @param id Dynamixel ID
+  /// @param instruction Instruction of the transaction
+  /// @param packet_length Length of the packet expected to be received
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setResponseTimeout(uint8_t id, uint8_t instruction, uint16_t packet_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds the time passed since PortHandler::setResponseTimeout() to the ResponseTimeEstimator
+  /// @description The time to transfer the status packet is taken out, so that the sample does not depend on the packet length.
+  /// @description The function does nothing when no estimator is set.
+  /// @param id Dynamixel ID which has responded
+  /// @param packet_length Length of the status packet received
+  ////////////////////////////////////////////////////////////////////////////////
+  void    addResponseTime(uint8_t id, uint16_t packet_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that tells the ResponseTimeEstimator that the response waited since PortHandler::setResponseTimeout() has timed out
+  /// @description The estimator backs off the timeout of the id and the instruction until the next response is measured.
+  /// @description The function does nothing when no estimator is set, or when no response is waited.
+  ////////////////////////////////////////////////////////////////////////////////
+  void    addResponseTimeout();
 };
 
 }
@@ -175,6 +175,13 @@ class PortHandlerArduino : public PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerArduino::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   bool    isPacketTimeout();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the time passed since the packet timeout was set
+  /// @description The function returns the time passed since the last call of PortHandlerArduino::setPacketTimeout().
+  /// @return Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getPacketElapsedTime();
 };
 
 }
@@ -28,6 +28,11 @@
 namespace dynamixel
 {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The type of the function that returns the current time of a monotonic clock in nanoseconds
+////////////////////////////////////////////////////////////////////////////////
+typedef int64_t (*ClockFunction)();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief The class for control port in Linux
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,18 +43,27 @@ class PortHandlerLinux : public PortHandler
   int     baudrate_;
   char    port_name_[100];
 
-  double  packet_start_time_;
-  double  packet_timeout_;
+  ClockFunction clock_;
+  int64_t packet_start_time_; // nsec, on the time base of clock_
+  int64_t packet_deadline_;   // nsec, on the time base of clock_
   double  tx_time_per_byte;
+  int     latency_timer_;     // msec
 
   bool    setupPort(const int cflag_baud);
   bool    setCustomBaudrate(int speed);
   int     getCFlagBaud(const int baudrate);
+  void    setupLowLatency();
 
-  double  getCurrentTime();
-  double  getTimeSinceStart();
+  int64_t getCurrentTime();
 
  public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the current time of CLOCK_MONOTONIC
+  /// @description The function is the default clock of PortHandlerLinux. It is not affected by NTP steps or date changes.
+  /// @return Time in nanoseconds
+  ////////////////////////////////////////////////////////////////////////////////
+  static int64_t getMonotonicTime();
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that initializes instance of PortHandler and gets port_name
   /// @description The function initializes instance of PortHandler and gets port_name.
@@ -112,6 +126,21 @@ class PortHandlerLinux : public PortHandler
   ////////////////////////////////////////////////////////////////////////////////
   int     getBaudRate();
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the latency timer of the USB serial adapter
+  /// @description The function returns the latency timer which was read from sysfs (and lowered if possible) when the port was opened.
+  /// @description When the adapter doesn't report its latency timer, the default of 16 msec is assumed.
+  /// @return Latency timer in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getLatencyTimer();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the file descriptor of the port
+  /// @description The descriptor is non-blocking, and may be watched by poll() or epoll() of an event loop.
+  /// @return File descriptor, or -1 when the port is not open
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getSocketFd();
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that checks how much bytes are able to be read from the port buffer
   /// @description The function checks how much bytes are able to be read from the port buffer
@@ -163,6 +192,39 @@ class PortHandlerLinux : public PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerLinux::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   bool    isPacketTimeout();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the time passed since the packet timeout was set
+  /// @description The function returns the time passed since the last call of PortHandlerLinux::setPacketTimeout().
+  /// @return Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getPacketElapsedTime();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the time left until the packet timeout
+  /// @description The function returns the time left until the time of packet timeout set by PortHandlerLinux::setPacketTimeout().
+  /// @return Time in msec, which is 0 or less after the timeout
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getPacketRemainingTime();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the clock used for watching packet timeout
+  /// @description The function replaces PortHandlerLinux::getMonotonicTime() by the clock,
+  /// @description so that packet timeouts can be driven by virtual time.
+  /// @description While the clock is replaced, PortHandlerLinux::waitForBytes() does not block.
+  /// @param clock Clock function, or 0 to restore PortHandlerLinux::getMonotonicTime()
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setClock(ClockFunction clock);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that waits until bytes are able to be read from the port buffer
+  /// @description The function polls the port until it becomes readable or the time of packet timeout
+  /// @description set by PortHandlerLinux::setPacketTimeout() is passed, so that an idle bus costs no CPU time.
+  /// @return false
+  /// @return   when the packet timeout has passed without bytes to read
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    waitForBytes();
 };
 
 }
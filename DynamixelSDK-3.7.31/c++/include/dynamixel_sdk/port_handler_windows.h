@@ -164,6 +164,13 @@ class WINDECLSPEC PortHandlerWindows : public PortHandler
   /// @description The function checks whether current time is passed by the time of packet timeout from the time set by PortHandlerWindows::setPacketTimeout().
   ////////////////////////////////////////////////////////////////////////////////
   bool    isPacketTimeout();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the time passed since the packet timeout was set
+  /// @description The function returns the time passed since the last call of PortHandlerWindows::setPacketTimeout().
+  /// @return Time in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getPacketElapsedTime();
 };
 
 }
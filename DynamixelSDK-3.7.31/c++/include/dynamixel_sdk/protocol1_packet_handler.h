@@ -38,6 +38,8 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
 
   Protocol1PacketHandler();
 
+  int         pollStatusPacket(PortHandler *port, uint8_t *rxpacket);   // PacketHandler::pollRxPacket() without releasing the port
+
  public:
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that returns Protocol1PacketHandler instance
@@ -86,7 +88,8 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that receives packet (rxpacket) during designated time via PortHandler port
-  /// @description The function repeatedly tries to receive rxpacket by PortHandler::readPort() function.
+  /// @description The function repeatedly tries to receive rxpacket by PortHandler::fillRxBuffer() function.
+  /// @description The bytes following rxpacket are left in the receive buffer of the port for the next call.
   /// @description It breaks out
   /// @description when PortHandler::isPacketTimeout() shows the timeout,
   /// @description when rxpacket seemed as corrupted, or
@@ -105,6 +108,17 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int rxPacket        (PortHandler *port, uint8_t *rxpacket);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives packet (rxpacket) from the bytes available now, without waiting
+  /// @description Protocol1PacketHandler::rxPacket() calls the function until it returns other than COMM_RX_WAITING.
+  /// @param port PortHandler instance
+  /// @param rxpacket received packet
+  /// @return COMM_RX_WAITING
+  /// @return   when rxpacket is not complete and PortHandler::isPacketTimeout() doesn't show the timeout yet
+  /// @return or the other communication results as Protocol1PacketHandler::rxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int pollRxPacket    (PortHandler *port, uint8_t *rxpacket);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits packet (txpacket) and receives packet (rxpacket) during designated time via PortHandler port
   /// @description The function calls Protocol1PacketHandler::txPacket(),
@@ -150,6 +164,21 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int ping            (PortHandler *port, uint8_t id, uint16_t *model_number, uint8_t *error = 0);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_PING instruction packet
+  /// @description The function makes an instruction packet with INST_PING,
+  /// @description transmits the packet with Protocol1PacketHandler::txPacket(),
+  /// @description and sets the packet timeout for the status packet, which is received by Protocol1PacketHandler::readRx() or Protocol1PacketHandler::pollReadRx().
+  /// @description It breaks out
+  /// @description when it tries to transmit to BROADCAST_ID
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when it tries to transmit to BROADCAST_ID
+  /// @return or the other communication results which come from Protocol1PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int pingTx          (PortHandler *port, uint8_t id);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief (Available only in Protocol 2.0) The function that pings all connected Dynamixel
   /// @param port PortHandler instance
@@ -158,6 +187,21 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int broadcastPing   (PortHandler *port, std::vector<uint8_t> &id_list);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief (Available only in Protocol 2.0) The function that pings all connected Dynamixel and stops when the bus goes quiet
+  /// @description The function parses the status packets as they arrive.
+  /// @description It stops when no byte came for idle_time after the last byte (or the transmission),
+  /// @description when expected_count Dynamixels are found, or after the time Protocol1PacketHandler::broadcastPing() waits.
+  /// @description Dynamixels answer in the order of their ID, so idle_time should cover the gap of the unused IDs
+  /// @description and the latency timer of the USB serial converter.
+  /// @param port PortHandler instance
+  /// @param id_list ID list of Dynamixels which are found by broadcast ping
+  /// @param idle_time Time in msec to wait for the next byte, or 0 to wait for all IDs
+  /// @param expected_count Number of Dynamixels to stop at, or 0 not to stop by the count
+  /// @return COMM_NOT_AVAILABLE
+  ////////////////////////////////////////////////////////////////////////////////
+  int broadcastPing   (PortHandler *port, std::vector<uint8_t> &id_list, double idle_time, int expected_count = 0);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that makes Dynamixels run as written in the Dynamixel register
   /// @description The function makes an instruction packet with INST_ACTION,
@@ -228,6 +272,17 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int readRx          (PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error = 0);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads the data in the packet as Protocol1PacketHandler::readRx(), without waiting
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @param length Length of the data for read
+  /// @param data Data extracted from the packet
+  /// @param error Dynamixel hardware error
+  /// @return communication results which come from Protocol1PacketHandler::pollRxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int pollReadRx      (PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error = 0);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_READ instruction packet, and read data from received packet
   /// @description The function makes an instruction packet with INST_READ,
@@ -365,6 +420,24 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int writeTxOnly     (PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_WRITE instruction packet with the data for write, and keeps the port for the status packet
+  /// @description The function makes an instruction packet with INST_WRITE and the data for write,
+  /// @description transmits the packet with Protocol1PacketHandler::txPacket().
+  /// @description The port stays in use until the status packet is received by Protocol1PacketHandler::pollReadRx() or Protocol1PacketHandler::readRx() with length 0.
+  /// @description It breaks out
+  /// @description when it tries to transmit to BROADCAST_ID
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param length Length of the data for write
+  /// @param data Data for write
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when it tries to transmit to BROADCAST_ID
+  /// @return or the other communication results which come from Protocol1PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int writeTx         (PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_WRITE instruction packet with the data for write, and receives the packet
   /// @description The function makes an instruction packet with INST_WRITE and the data for write,
@@ -495,6 +568,35 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   // SyncReadRx   -> GroupSyncRead class
   // SyncReadTxRx -> GroupSyncRead class
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief (Available only in Protocol 2.0) The function that transmits Fast Sync Read instruction packet
+  /// @param port PortHandler instance
+  /// @param start_address Address of the data for Fast Sync Read
+  /// @param data_length Length of the data for Fast Sync Read
+  /// @param param Parameter for Fast Sync Read
+  /// @param param_length Length of the data for Fast Sync Read
+  /// @return COMM_NOT_AVAILABLE
+  ////////////////////////////////////////////////////////////////////////////////
+  int fastSyncReadTx  (PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief (Available only in Protocol 2.0) The function that receives the status packet of Fast Sync Read or Fast Bulk Read
+  /// @param port PortHandler instance
+  /// @param length Length of the parameter for read
+  /// @param param Parameter extracted from the packet
+  /// @return COMM_NOT_AVAILABLE
+  ////////////////////////////////////////////////////////////////////////////////
+  int fastReadRx      (PortHandler *port, uint16_t length, uint8_t *param);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads the parameter in the packet as Protocol1PacketHandler::fastReadRx(), without waiting
+  /// @param port PortHandler instance
+  /// @param length Length of the parameter for read
+  /// @param param Parameter extracted from the packet
+  /// @return COMM_NOT_AVAILABLE
+  ////////////////////////////////////////////////////////////////////////////////
+  int pollFastReadRx  (PortHandler *port, uint16_t length, uint8_t *param);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits Sync Write instruction packet
   /// @description The function makes an instruction packet with INST_SYNC_WRITE,
@@ -508,6 +610,43 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int syncWriteTxOnly (PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes Sync Write instruction packet to be transmitted repeatedly
+  /// @description The function makes a complete instruction packet with INST_SYNC_WRITE and its checksum in txpacket.
+  /// @param txpacket Buffer of param_length + 8 bytes at least
+  /// @param start_address Address of the data for Sync Write
+  /// @param data_length Length of the data for Sync Write
+  /// @param param Parameter for Sync Write {ID1, DATA0, DATA1, ..., DATAn, ID2, DATA0, DATA1, ..., DATAn, ID3, DATA0, DATA1, ..., DATAn}
+  /// @param param_length Length of the data for Sync Write
+  /// @return 0
+  /// @return   when the packet is too long
+  /// @return or length of the packet
+  ////////////////////////////////////////////////////////////////////////////////
+  uint16_t makeSyncWritePacket(uint8_t *txpacket, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that changes a part of the parameter in the packet made by Protocol1PacketHandler::makeSyncWritePacket()
+  /// @description The function updates the checksum with the difference of the changed bytes.
+  /// @param txpacket Packet made by Protocol1PacketHandler::makeSyncWritePacket()
+  /// @param param_index Index of the data in the parameter for Sync Write
+  /// @param data Data for write
+  /// @param length Length of the data
+  /// @return true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool updateSyncWritePacket(uint8_t *txpacket, uint16_t param_index, uint8_t *data, uint16_t length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits the packet made by Protocol1PacketHandler::makeSyncWritePacket()
+  /// @param port PortHandler instance
+  /// @param txpacket Packet made by Protocol1PacketHandler::makeSyncWritePacket()
+  /// @return COMM_PORT_BUSY
+  /// @return   when the port is already in use
+  /// @return COMM_TX_FAIL
+  /// @return   when it failed to write the packet
+  /// @return or COMM_SUCCESS
+  ////////////////////////////////////////////////////////////////////////////////
+  int txSyncWritePacket(PortHandler *port, uint8_t *txpacket);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief (Available only on Dynamixel MX / X series) The function that transmits Bulk Read instruction packet
   /// @description The function makes an instruction packet with INST_BULK_READ,
@@ -521,6 +660,15 @@ class WINDECLSPEC Protocol1PacketHandler : public PacketHandler
   // BulkReadRx   -> GroupBulkRead class
   // BulkReadTxRx -> GroupBulkRead class
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief (Available only in Protocol 2.0) The function that transmits Fast Bulk Read instruction packet
+  /// @param port PortHandler instance
+  /// @param param Parameter for Fast Bulk Read
+  /// @param param_length Length of the data for Fast Bulk Read
+  /// @return COMM_NOT_AVAILABLE
+  ////////////////////////////////////////////////////////////////////////////////
+  int fastBulkReadTx  (PortHandler *port, uint8_t *param, uint16_t param_length);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief (Available only in Protocol 2.0) The function that transmits Bulk Write instruction packet
   /// @param port PortHandler instance
@@ -39,9 +39,13 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   Protocol2PacketHandler();
 
   uint16_t    updateCRC(uint16_t crc_accum, uint8_t *data_blk_ptr, uint16_t data_blk_size);
+  uint16_t    shiftCRC(uint16_t crc_accum, uint16_t zero_length);
+  uint16_t    findHeader(uint8_t *data, uint16_t length);
   void        addStuffing(uint8_t *packet);
   void        removeStuffing(uint8_t *packet);
 
+  int         pollStatusPacket(PortHandler *port, uint8_t *rxpacket);   // PacketHandler::pollRxPacket() without releasing the port
+
  public:
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that returns Protocol2PacketHandler instance
@@ -90,7 +94,8 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
 
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that receives packet (rxpacket) during designated time via PortHandler port
-  /// @description The function repeatedly tries to receive rxpacket by PortHandler::readPort() function.
+  /// @description The function repeatedly tries to receive rxpacket by PortHandler::fillRxBuffer() function.
+  /// @description The bytes following rxpacket are left in the receive buffer of the port for the next call.
   /// @description It breaks out
   /// @description when PortHandler::isPacketTimeout() shows the timeout,
   /// @description when rxpacket seemed as corrupted, or
@@ -109,6 +114,17 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int rxPacket        (PortHandler *port, uint8_t *rxpacket);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives packet (rxpacket) from the bytes available now, without waiting
+  /// @description Protocol2PacketHandler::rxPacket() calls the function until it returns other than COMM_RX_WAITING.
+  /// @param port PortHandler instance
+  /// @param rxpacket received packet
+  /// @return COMM_RX_WAITING
+  /// @return   when rxpacket is not complete and PortHandler::isPacketTimeout() doesn't show the timeout yet
+  /// @return or the other communication results as Protocol2PacketHandler::rxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int pollRxPacket    (PortHandler *port, uint8_t *rxpacket);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits packet (txpacket) and receives packet (rxpacket) during designated time via PortHandler port
   /// @description The function calls Protocol2PacketHandler::txPacket(),
@@ -154,6 +170,21 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int ping            (PortHandler *port, uint8_t id, uint16_t *model_number, uint8_t *error = 0);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_PING instruction packet
+  /// @description The function makes an instruction packet with INST_PING,
+  /// @description transmits the packet with Protocol2PacketHandler::txPacket(),
+  /// @description and sets the packet timeout for the status packet, which is received by Protocol2PacketHandler::readRx() or Protocol2PacketHandler::pollReadRx().
+  /// @description It breaks out
+  /// @description when it tries to transmit to BROADCAST_ID
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when it tries to transmit to BROADCAST_ID
+  /// @return or the other communication results which come from Protocol2PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int pingTx          (PortHandler *port, uint8_t id);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief (Available only in Protocol 2.0) The function that pings all connected Dynamixel
   /// @param port PortHandler instance
@@ -162,6 +193,21 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int broadcastPing   (PortHandler *port, std::vector<uint8_t> &id_list);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief (Available only in Protocol 2.0) The function that pings all connected Dynamixel and stops when the bus goes quiet
+  /// @description The function parses the status packets as they arrive.
+  /// @description It stops when no byte came for idle_time after the last byte (or the transmission),
+  /// @description when expected_count Dynamixels are found, or after the time Protocol2PacketHandler::broadcastPing() waits.
+  /// @description Dynamixels answer in the order of their ID, so idle_time should cover the gap of the unused IDs
+  /// @description and the latency timer of the USB serial converter.
+  /// @param port PortHandler instance
+  /// @param id_list ID list of Dynamixels which are found by broadcast ping
+  /// @param idle_time Time in msec to wait for the next byte, or 0 to wait for all IDs
+  /// @param expected_count Number of Dynamixels to stop at, or 0 not to stop by the count
+  /// @return COMM_NOT_AVAILABLE
+  ////////////////////////////////////////////////////////////////////////////////
+  int broadcastPing   (PortHandler *port, std::vector<uint8_t> &id_list, double idle_time, int expected_count = 0);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that makes Dynamixels run as written in the Dynamixel register
   /// @description The function makes an instruction packet with INST_ACTION,
@@ -240,6 +286,17 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int readRx          (PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error = 0);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads the data in the packet as Protocol2PacketHandler::readRx(), without waiting
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @param length Length of the data for read
+  /// @param data Data extracted from the packet
+  /// @param error Dynamixel hardware error
+  /// @return communication results which come from Protocol2PacketHandler::pollRxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int pollReadRx      (PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error = 0);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_READ instruction packet, and read data from received packet
   /// @description The function makes an instruction packet with INST_READ,
@@ -377,6 +434,24 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int writeTxOnly     (PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_WRITE instruction packet with the data for write, and keeps the port for the status packet
+  /// @description The function makes an instruction packet with INST_WRITE and the data for write,
+  /// @description transmits the packet with Protocol2PacketHandler::txPacket().
+  /// @description The port stays in use until the status packet is received by Protocol2PacketHandler::pollReadRx() or Protocol2PacketHandler::readRx() with length 0.
+  /// @description It breaks out
+  /// @description when it tries to transmit to BROADCAST_ID
+  /// @param port PortHandler instance
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param length Length of the data for write
+  /// @param data Data for write
+  /// @return COMM_NOT_AVAILABLE
+  /// @return   when it tries to transmit to BROADCAST_ID
+  /// @return or the other communication results which come from Protocol2PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int writeTx         (PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_WRITE instruction packet with the data for write, and receives the packet
   /// @description The function makes an instruction packet with INST_WRITE and the data for write,
@@ -510,6 +585,43 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   // SyncReadRx   -> GroupSyncRead class
   // SyncReadTxRx -> GroupSyncRead class
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_FAST_SYNC_READ instruction packet
+  /// @description The function makes an instruction packet with INST_FAST_SYNC_READ,
+  /// @description transmits the packet with Protocol2PacketHandler::txPacket().
+  /// @param port PortHandler instance
+  /// @param start_address Address of the data for Fast Sync Read
+  /// @param data_length Length of the data for Fast Sync Read
+  /// @param param Parameter for Fast Sync Read {ID1, ID2, ID3, ...}
+  /// @param param_length Length of the data for Fast Sync Read
+  /// @return communication results which come from Protocol2PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int fastSyncReadTx  (PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that receives the status packet of Fast Sync Read or Fast Bulk Read and reads the parameter in the packet
+  /// @description The function receives the status packet with BROADCAST_ID,
+  /// @description and gets the parameter {ERROR1, ID1, DATA1..., CRC16_L1, CRC16_H1, ERROR2, ID2, DATA2..., ...} from the packet.
+  /// @param port PortHandler instance
+  /// @param length Length of the parameter for read
+  /// @param param Parameter extracted from the packet
+  /// @return COMM_RX_CORRUPT
+  /// @return   when the length of the parameter differs from length
+  /// @return or the other communication results which come from Protocol2PacketHandler::rxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int fastReadRx      (PortHandler *port, uint16_t length, uint8_t *param);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that reads the parameter in the packet as Protocol2PacketHandler::fastReadRx(), without waiting
+  /// @param port PortHandler instance
+  /// @param length Length of the parameter for read
+  /// @param param Parameter extracted from the packet
+  /// @return COMM_RX_CORRUPT
+  /// @return   when the length of the parameter differs from length
+  /// @return or the other communication results which come from Protocol2PacketHandler::pollRxPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int pollFastReadRx  (PortHandler *port, uint16_t length, uint8_t *param);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_SYNC_WRITE instruction packet
   /// @description The function makes an instruction packet with INST_SYNC_WRITE,
@@ -523,6 +635,46 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   ////////////////////////////////////////////////////////////////////////////////
   int syncWriteTxOnly (PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that makes INST_SYNC_WRITE instruction packet to be transmitted repeatedly
+  /// @description The function makes a complete instruction packet with INST_SYNC_WRITE and its CRC16 in txpacket.
+  /// @param txpacket Buffer of param_length + 14 bytes at least
+  /// @param start_address Address of the data for Sync Write
+  /// @param data_length Length of the data for Sync Write
+  /// @param param Parameter for Sync Write {ID1, DATA0, DATA1, ..., DATAn, ID2, DATA0, DATA1, ..., DATAn, ID3, DATA0, DATA1, ..., DATAn}
+  /// @param param_length Length of the data for Sync Write
+  /// @return 0
+  /// @return   when the packet is too long or needs byte stuffing
+  /// @return or length of the packet
+  ////////////////////////////////////////////////////////////////////////////////
+  uint16_t makeSyncWritePacket(uint8_t *txpacket, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that changes a part of the parameter in the packet made by Protocol2PacketHandler::makeSyncWritePacket()
+  /// @description As CRC16 is linear, the function adds the CRC16 of the changed bits to the CRC16 of the packet,
+  /// @description so that only the changed bytes are calculated.
+  /// @param txpacket Packet made by Protocol2PacketHandler::makeSyncWritePacket()
+  /// @param param_index Index of the data in the parameter for Sync Write
+  /// @param data Data for write
+  /// @param length Length of the data
+  /// @return false
+  /// @return   when the packet needs byte stuffing with the data
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool updateSyncWritePacket(uint8_t *txpacket, uint16_t param_index, uint8_t *data, uint16_t length);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits the packet made by Protocol2PacketHandler::makeSyncWritePacket()
+  /// @param port PortHandler instance
+  /// @param txpacket Packet made by Protocol2PacketHandler::makeSyncWritePacket()
+  /// @return COMM_PORT_BUSY
+  /// @return   when the port is already in use
+  /// @return COMM_TX_FAIL
+  /// @return   when it failed to write the packet
+  /// @return or COMM_SUCCESS
+  ////////////////////////////////////////////////////////////////////////////////
+  int txSyncWritePacket(PortHandler *port, uint8_t *txpacket);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_BULK_READ instruction packet
   /// @description The function makes an instruction packet with INST_BULK_READ,
@@ -536,6 +688,17 @@ class WINDECLSPEC Protocol2PacketHandler : public PacketHandler
   // BulkReadRx   -> GroupBulkRead class
   // BulkReadTxRx -> GroupBulkRead class
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that transmits INST_FAST_BULK_READ instruction packet
+  /// @description The function makes an instruction packet with INST_FAST_BULK_READ,
+  /// @description transmits the packet with Protocol2PacketHandler::txPacket().
+  /// @param port PortHandler instance
+  /// @param param Parameter for Fast Bulk Read {ID1, ADDR_L1, ADDR_H1, LEN_L1, LEN_H1, ID2, ADDR_L2, ADDR_H2, LEN_L2, LEN_H2, ...}
+  /// @param param_length Length of the data for Fast Bulk Read
+  /// @return communication results which come from Protocol2PacketHandler::txPacket()
+  ////////////////////////////////////////////////////////////////////////////////
+  int fastBulkReadTx  (PortHandler *port, uint8_t *param, uint16_t param_length);
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief The function that transmits INST_BULK_WRITE instruction packet
   /// @description The function makes an instruction packet with INST_BULK_WRITE,
@@ -0,0 +1,138 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for skipping the writes of the values which Dynamixel already has
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_REGISTERCACHE_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_REGISTERCACHE_H_
+
+
+#include <vector>
+#include "port_handler.h"
+#include "packet_handler.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that keeps the last acknowledged value of each register and skips the writes which do not change it
+/// @description A value is kept when the write gets a status packet without error.
+/// @description A write of the same value, or of a value within the deadband of the address, returns COMM_SUCCESS without communication.
+/// @description A write to BROADCAST_ID is always sent and forgets the address for all IDs.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC RegisterCache
+{
+ private:
+  struct Register
+  {
+    uint16_t  address;
+    uint16_t  length;
+    uint32_t  value;
+  };
+
+  struct Deadband
+  {
+    uint16_t  address;
+    uint32_t  deadband;
+  };
+
+  PortHandler    *port_;
+  PacketHandler  *ph_;
+
+  std::vector<Register> register_list_[BROADCAST_ID];   // [id]
+  std::vector<Deadband> deadband_list_;
+
+  int     write(uint8_t id, uint16_t address, uint16_t length, uint32_t data, uint8_t *error);
+  bool    isUnchanged(uint8_t id, uint16_t address, uint16_t length, uint32_t data);
+  void    remove(uint8_t id, uint16_t address, uint16_t length);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of RegisterCache
+  /// @param port PortHandler instance
+  /// @param ph PacketHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  RegisterCache(PortHandler *port, PacketHandler *ph);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the deadband of an address, such as the goal position
+  /// @description A write whose value differs from the kept value by the deadband or less is skipped.
+  /// @param address Address of the data
+  /// @param deadband Deadband, or 0 to skip only the same value
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setDeadband(uint16_t address, uint32_t deadband);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that calls PacketHandler::write1ByteTxRx() when the value changes
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param data Data for write
+  /// @param error Dynamixel hardware error
+  /// @return COMM_SUCCESS
+  /// @return   when the value is not changed
+  /// @return or the communication results which come from PacketHandler::write1ByteTxRx()
+  ////////////////////////////////////////////////////////////////////////////////
+  int     write1ByteTxRx(uint8_t id, uint16_t address, uint8_t data, uint8_t *error = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that calls PacketHandler::write2ByteTxRx() when the value changes
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param data Data for write
+  /// @param error Dynamixel hardware error
+  /// @return COMM_SUCCESS
+  /// @return   when the value is not changed
+  /// @return or the communication results which come from PacketHandler::write2ByteTxRx()
+  ////////////////////////////////////////////////////////////////////////////////
+  int     write2ByteTxRx(uint8_t id, uint16_t address, uint16_t data, uint8_t *error = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that calls PacketHandler::write4ByteTxRx() when the value changes
+  /// @param id Dynamixel ID
+  /// @param address Address of the data for write
+  /// @param data Data for write
+  /// @param error Dynamixel hardware error
+  /// @return COMM_SUCCESS
+  /// @return   when the value is not changed
+  /// @return or the communication results which come from PacketHandler::write4ByteTxRx()
+  ////////////////////////////////////////////////////////////////////////////////
+  int     write4ByteTxRx(uint8_t id, uint16_t address, uint32_t data, uint8_t *error = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the kept value of a register
+  /// @param id Dynamixel ID
+  /// @param address Address of the data
+  /// @param length Length of the data
+  /// @param data Kept value
+  /// @return false
+  /// @return   when no value is kept for the register
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    getValue(uint8_t id, uint16_t address, uint16_t length, uint32_t *data);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that forgets the values of a Dynamixel, for example after it was rebooted
+  /// @param id Dynamixel ID, or BROADCAST_ID for all Dynamixels
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clear(uint8_t id = BROADCAST_ID);
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_REGISTERCACHE_H_ */
@@ -0,0 +1,128 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for estimating response time of Dynamixel
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_RESPONSETIMEESTIMATOR_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_RESPONSETIMEESTIMATOR_H_
+
+
+#include <vector>
+#include "port_handler.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that estimates the response time of each Dynamixel for packet timeouts
+/// @description The class keeps a smoothed mean and mean deviation of the response time per ID and per instruction,
+/// @description in the same way as the TCP retransmission timer (RFC 6298).
+/// @description The response time is measured until the status packet begins, so that it does not depend on the packet length.
+/// @description The timeout is mean + 4 * deviation, limited by the minimum and maximum timeout,
+/// @description and PortHandler::setResponseTimeout() adds the time to transfer the status packet to it.
+/// @description The timeout is doubled on every timeout of the ID until a response is measured again, like the backoff of RFC 6298.
+/// @description An ID which has never answered gets the timeout estimated from all the other IDs.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC ResponseTimeEstimator
+{
+ private:
+  struct Statistics
+  {
+    double    mean;       // msec
+    double    deviation;  // msec
+    uint32_t  count;
+    uint8_t   backoff;    // timeouts since the last response, the timeout is doubled for each
+  };
+
+  std::vector<Statistics> statistics_;  // [id][instruction slot]
+
+  double  min_timeout_;
+  double  max_timeout_;
+  double  default_timeout_;
+
+  Statistics *getStatistics(uint8_t id, uint8_t instruction);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of ResponseTimeEstimator
+  /// @param min_timeout Minimum timeout in msec
+  /// @param max_timeout Maximum timeout in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  ResponseTimeEstimator(double min_timeout = 2.0, double max_timeout = 100.0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the limits of the estimated timeout
+  /// @param min_timeout Minimum timeout in msec
+  /// @param max_timeout Maximum timeout in msec
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setTimeoutLimit(double min_timeout, double max_timeout);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that sets the timeout used before any ID has answered to the instruction
+  /// @param default_timeout Timeout in msec, or -1.0 to use the timeout by the packet length
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setDefaultTimeout(double default_timeout) { default_timeout_ = default_timeout; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a response time measured from a successful transaction
+  /// @param id Dynamixel ID
+  /// @param instruction Instruction of the transaction
+  /// @param msec Time from the instruction packet to the beginning of the status packet
+  ////////////////////////////////////////////////////////////////////////////////
+  void    addSample(uint8_t id, uint8_t instruction, double msec);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a timeout of a transaction, which doubles the timeout of the ID until the next sample
+  /// @param id Dynamixel ID
+  /// @param instruction Instruction of the transaction
+  ////////////////////////////////////////////////////////////////////////////////
+  void    addTimeout(uint8_t id, uint8_t instruction);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the packet timeout estimated from the response times
+  /// @param id Dynamixel ID
+  /// @param instruction Instruction of the transaction
+  /// @return -1.0
+  /// @return   when no response time has been measured for the instruction and no default timeout is set
+  /// @return or Timeout in msec, without the time to transfer the status packet
+  ////////////////////////////////////////////////////////////////////////////////
+  double  getTimeout(uint8_t id, uint8_t instruction);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that gets the statistics of the response time
+  /// @param id Dynamixel ID, or BROADCAST_ID for the statistics over all IDs
+  /// @param instruction Instruction of the transaction
+  /// @param mean Smoothed mean of the response time in msec
+  /// @param deviation Smoothed mean deviation of the response time in msec
+  /// @param count Number of measured response times
+  /// @return false
+  /// @return   when no response time has been measured
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    getStatistics(uint8_t id, uint8_t instruction, double *mean, double *deviation, uint32_t *count = 0);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that clears all the measured response times
+  ////////////////////////////////////////////////////////////////////////////////
+  void    clear();
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_RESPONSETIMEESTIMATOR_H_ */
@@ -0,0 +1,163 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for sharing a port between threads through a queue of transactions run by one bus thread
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_TRANSACTIONQUEUE_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_TRANSACTIONQUEUE_H_
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "port_handler.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class of a job submitted to TransactionQueue, such as a TxRx or a Sync Read
+/// @description The submitter keeps the instance until Transaction::run() returns.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC Transaction
+{
+ private:
+  friend class TransactionQueue;
+  std::atomic<Transaction *> next_;
+
+ public:
+  Transaction() : next_(0) { }
+  virtual ~Transaction() { }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that communicates with the Dynamixels
+  /// @description The function is called on the bus thread, while the bus thread owns the port by PortHandler::lockPort().
+  /// @param port PortHandler instance of the queue
+  ////////////////////////////////////////////////////////////////////////////////
+  virtual void run(PortHandler *port) = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that runs the transactions submitted by any thread, one by one in the order submitted, on its own bus thread
+/// @description TransactionQueue::submit() does not lock: the transactions are linked into a multi-producer single-consumer queue.
+/// @description The bus thread sleeps while the queue is empty, and is woken by the next submit.
+////////////////////////////////////////////////////////////////////////////////
+class WINDECLSPEC TransactionQueue
+{
+ private:
+  class Stub : public Transaction
+  {
+   public:
+    void run(PortHandler *) { }
+  };
+
+  PortHandler  *port_;
+
+  Stub                        stub_;
+  Transaction                *head_;      // taken by the bus thread
+  std::atomic<Transaction *>  tail_;      // put by the submitters
+  std::atomic<int>            pending_count_;
+  int                         max_pending_;
+
+  std::atomic<bool>           is_running_;
+  std::atomic<bool>           is_sleeping_;
+  std::mutex                  mutex_;
+  std::condition_variable     condition_;
+  std::thread                 thread_;
+
+  void          push(Transaction *transaction);
+  Transaction  *pop();
+  bool          isEmpty();
+  void          process();
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of TransactionQueue
+  /// @param port PortHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  TransactionQueue(PortHandler *port);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that calls TransactionQueue::stop()
+  ////////////////////////////////////////////////////////////////////////////////
+  ~TransactionQueue() { stop(); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns PortHandler instance
+  /// @return PortHandler instance
+  ////////////////////////////////////////////////////////////////////////////////
+  PortHandler *getPortHandler() { return port_; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that limits the number of transactions waiting in the queue
+  /// @description With the limit, the time a transaction waits is bounded by the time of the transactions before it.
+  /// @param max_pending Number of transactions, or 0 for no limit (default)
+  ////////////////////////////////////////////////////////////////////////////////
+  void    setMaxPending(int max_pending) { max_pending_ = max_pending; }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the number of transactions waiting in the queue
+  /// @return Number of transactions which have not started
+  ////////////////////////////////////////////////////////////////////////////////
+  int     getPendingCount() { return pending_count_.load(); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that starts the bus thread
+  /// @return false
+  /// @return   when the bus thread is already running
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    start();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether the bus thread is running
+  /// @return true when the bus thread is running
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isRunning() { return is_running_.load(); }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that runs the transactions already submitted, and stops the bus thread
+  ////////////////////////////////////////////////////////////////////////////////
+  void    stop();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that puts a transaction at the end of the queue
+  /// @description The function may be called by any thread, and by Transaction::run() on the bus thread.
+  /// @param transaction Transaction instance, which is kept by the caller until its Transaction::run() returns
+  /// @return false
+  /// @return   when the queue has the number of transactions set by TransactionQueue::setMaxPending()
+  /// @return   when the bus thread is not running, so that the transaction would never run
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    submit(Transaction *transaction);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that checks whether the caller is the bus thread
+  /// @description A transaction should not wait for another transaction of the same queue on the bus thread.
+  /// @return true when the caller is the bus thread
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    isBusThread() { return std::this_thread::get_id() == thread_.get_id(); }
+};
+
+}
+
+#endif
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SDK_TRANSACTIONQUEUE_H_ */
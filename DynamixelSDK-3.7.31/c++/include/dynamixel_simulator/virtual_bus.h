@@ -0,0 +1,112 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for the simulated Dynamixel bus on a pseudo terminal
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SIMULATOR_VIRTUALBUS_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SIMULATOR_VIRTUALBUS_H_
+
+
+#include <vector>
+#include "virtual_dynamixel.h"
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that simulates Dynamixels connected on a pseudo terminal
+/// @description The slave side of the pseudo terminal behaves like the port of U2D2,
+/// @description so that PortHandlerLinux opens it without any change.
+/// @description The received instruction packets and the status packets are throttled to the baudrate set on the port,
+/// @description and each status packet is sent after the return delay time in the control table of the Dynamixel.
+/// @description A Dynamixel whose baudrate in the control table differs from the port doesn't respond.
+////////////////////////////////////////////////////////////////////////////////
+class VirtualBus
+{
+ private:
+  float   protocol_version_;
+  int     default_baudrate_;
+
+  int     master_fd_;
+  int     slave_fd_;
+  char    port_name_[100];
+
+  std::vector<VirtualDynamixel *> dxl_list_;
+
+  std::vector<uint8_t>  rx_buffer_;
+  std::vector<uint8_t>  tx_buffer_;
+  double  bus_free_time_;   // time when the last byte on the bus is over
+
+  double  getCurrentTime();
+  int     getPortBaudRate();
+  double  getByteTime();
+
+  VirtualDynamixel *findDynamixel(uint8_t id);
+
+  bool    isResponding(VirtualDynamixel *dxl, uint8_t instruction);
+  void    transmit(const uint8_t *data, int length, double start_time);
+  void    sendStatus(VirtualDynamixel *dxl, uint8_t error, const uint8_t *param, uint16_t param_length);
+  void    sendFastStatus(const std::vector<uint8_t> &id_list, const std::vector<uint16_t> &address_list, const std::vector<uint16_t> &length_list);
+
+  int     parsePacket1();
+  int     parsePacket2();
+  void    processPacket1(uint8_t id, uint8_t instruction, const uint8_t *param, uint16_t param_length);
+  void    processPacket2(uint8_t id, uint8_t instruction, const uint8_t *param, uint16_t param_length);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of VirtualBus
+  /// @param protocol_version Protocol version of the Dynamixels on the bus (1.0 or 2.0)
+  /// @param baudrate Baudrate used when the port doesn't tell its baudrate
+  ////////////////////////////////////////////////////////////////////////////////
+  VirtualBus(float protocol_version, int baudrate);
+
+  virtual ~VirtualBus();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that adds a Dynamixel to the bus
+  /// @param id Dynamixel ID
+  /// @param return_delay_usec Return delay time in usec
+  ////////////////////////////////////////////////////////////////////////////////
+  void    addDynamixel(uint8_t id, int return_delay_usec);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that opens the pseudo terminal
+  /// @return false
+  /// @return   when the pseudo terminal couldn't be opened
+  /// @return or true
+  ////////////////////////////////////////////////////////////////////////////////
+  bool    openPort();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that returns the port name which PortHandler opens
+  /// @return Port name like /dev/pts/N
+  ////////////////////////////////////////////////////////////////////////////////
+  char   *getPortName();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that handles the instruction packets until the time passes
+  /// @param msec Time to run in msec, or negative value to handle only the bytes already received
+  ////////////////////////////////////////////////////////////////////////////////
+  void    run(int msec);
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SIMULATOR_VIRTUALBUS_H_ */
@@ -0,0 +1,114 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+/// @file The file for the control table of a simulated Dynamixel
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SIMULATOR_VIRTUALDYNAMIXEL_H_
+#define DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SIMULATOR_VIRTUALDYNAMIXEL_H_
+
+
+#include <stdint.h>
+#include <vector>
+
+namespace dynamixel
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief The class that simulates the control table of one Dynamixel
+/// @description Protocol 2.0 Dynamixels have the control table of XM430-W350,
+/// @description and Protocol 1.0 Dynamixels have the control table of MX-28.
+/// @description Errors are returned as the error byte of the status packet of the protocol.
+////////////////////////////////////////////////////////////////////////////////
+class VirtualDynamixel
+{
+ public:
+  struct ControlTableItem
+  {
+    uint16_t  address;
+    uint8_t   size;
+    uint8_t   access;
+    int32_t   initial_value;
+  };
+
+ private:
+  float     protocol_version_;
+  uint16_t  default_id_;
+  int       default_baudrate_;
+  uint16_t  default_return_delay_;
+
+  const ControlTableItem *items_;
+  int                     item_count_;
+
+  std::vector<uint8_t>  table_;
+  std::vector<uint8_t>  access_;      // access of each address
+
+  std::vector<uint8_t>  registered_data_;
+  uint16_t              registered_address_;
+
+  double    position_;                // present position in the unit of the control table
+  double    last_update_time_;
+
+  uint16_t  getIndirectAddress(uint16_t address);
+  void      initialize(bool keep_id, bool keep_baudrate);
+
+ public:
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that initializes instance of VirtualDynamixel
+  /// @param id Dynamixel ID
+  /// @param protocol_version Protocol version (1.0 or 2.0)
+  /// @param baudrate Baudrate written in the control table
+  /// @param return_delay_usec Return delay time written in the control table in usec
+  ////////////////////////////////////////////////////////////////////////////////
+  VirtualDynamixel(uint8_t id, float protocol_version, int baudrate, int return_delay_usec);
+
+  uint8_t   getID();
+  float     getProtocolVersion();
+  int       getBaudRate();
+  double    getReturnDelayTime();       // usec
+  uint8_t   getStatusReturnLevel();
+  uint16_t  getModelNumber();
+  uint8_t   getFirmwareVersion();
+  uint16_t  getControlTableSize();
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The function that moves the simulated horn to the time
+  /// @param now Time in sec
+  ////////////////////////////////////////////////////////////////////////////////
+  void      update(double now);
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief The functions that access the control table as the instructions do
+  /// @return 0
+  /// @return   when succeeded
+  /// @return or the error byte of the status packet
+  ////////////////////////////////////////////////////////////////////////////////
+  uint8_t   read(uint16_t address, uint16_t length, uint8_t *data);
+  uint8_t   write(uint16_t address, uint16_t length, const uint8_t *data);
+  uint8_t   regWrite(uint16_t address, uint16_t length, const uint8_t *data);
+  uint8_t   action();
+  uint8_t   factoryReset(uint8_t option);
+  uint8_t   reboot();
+
+  uint8_t   getInstructionError();
+  uint8_t   getCRCError();
+};
+
+}
+
+
+#endif /* DYNAMIXEL_SDK_INCLUDE_DYNAMIXEL_SIMULATOR_VIRTUALDYNAMIXEL_H_ */
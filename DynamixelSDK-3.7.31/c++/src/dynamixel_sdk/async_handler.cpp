@@ -0,0 +1,171 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include "async_handler.h"
+#elif defined(__APPLE__)
+#include "async_handler.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "async_handler.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/async_handler.h"
+#endif
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+
+#include <vector>
+
+using namespace dynamixel;
+
+namespace
+{
+
+// the transaction which deletes itself after it has set the future
+class AsyncTransaction : public Transaction
+{
+ public:
+  std::function<int(PortHandler *)> job;
+  AsyncHandler::Callback            callback;
+  void                             *arg;
+  std::promise<int>                 promise;
+
+  void run(PortHandler *port)
+  {
+    int result = job(port);
+    if (callback != 0)
+      callback(result, arg);
+    promise.set_value(result);
+    delete this;
+  }
+};
+
+}
+
+AsyncHandler::AsyncHandler(PortHandler *port, PacketHandler *ph)
+  : port_(port),
+    ph_(ph),
+    queue_(port)
+{
+  queue_.start();
+}
+
+std::future<int> AsyncHandler::submit(const std::function<int(PortHandler *)> &job, Callback callback, void *arg)
+{
+  AsyncTransaction *transaction = new AsyncTransaction();
+  transaction->job      = job;
+  transaction->callback = callback;
+  transaction->arg      = arg;
+
+  std::future<int> future = transaction->promise.get_future();
+  if (queue_.submit(transaction) == false)
+  {
+    int result = (queue_.isRunning() == true) ? COMM_PORT_BUSY : COMM_NOT_AVAILABLE;
+    if (callback != 0)
+      callback(result, arg);
+    transaction->promise.set_value(result);
+    delete transaction;
+  }
+
+  return future;
+}
+
+std::future<int> AsyncHandler::ping(uint8_t id, uint16_t *model_number, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->ping(port, id, model_number, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::readTxRx(uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->readTxRx(port, id, address, length, data, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::read1ByteTxRx(uint8_t id, uint16_t address, uint8_t *data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->read1ByteTxRx(port, id, address, data, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::read2ByteTxRx(uint8_t id, uint16_t address, uint16_t *data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->read2ByteTxRx(port, id, address, data, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::read4ByteTxRx(uint8_t id, uint16_t address, uint32_t *data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->read4ByteTxRx(port, id, address, data, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::writeTxRx(uint8_t id, uint16_t address, uint16_t length, const uint8_t *data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  std::vector<uint8_t> buffer(data, data + length);
+  return submit([=](PortHandler *port) mutable { return ph->writeTxRx(port, id, address, length, buffer.data(), error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::write1ByteTxRx(uint8_t id, uint16_t address, uint8_t data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->write1ByteTxRx(port, id, address, data, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::write2ByteTxRx(uint8_t id, uint16_t address, uint16_t data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->write2ByteTxRx(port, id, address, data, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::write4ByteTxRx(uint8_t id, uint16_t address, uint32_t data, uint8_t *error, Callback callback, void *arg)
+{
+  PacketHandler *ph = ph_;
+  return submit([=](PortHandler *port) { return ph->write4ByteTxRx(port, id, address, data, error); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::txRxPacket(GroupSyncRead &group, Callback callback, void *arg)
+{
+  GroupSyncRead *g = &group;
+  return submit([=](PortHandler *) { return g->txRxPacket(); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::txRxPacket(GroupBulkRead &group, Callback callback, void *arg)
+{
+  GroupBulkRead *g = &group;
+  return submit([=](PortHandler *) { return g->txRxPacket(); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::txRxPacket(CyclePlan &plan, Callback callback, void *arg)
+{
+  CyclePlan *p = &plan;
+  return submit([=](PortHandler *) { return p->txRxPacket(); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::txPacket(GroupSyncWrite &group, Callback callback, void *arg)
+{
+  GroupSyncWrite *g = &group;
+  return submit([=](PortHandler *) { return g->txPacket(); }, callback, arg);
+}
+
+std::future<int> AsyncHandler::txPacket(GroupBulkWrite &group, Callback callback, void *arg)
+{
+  GroupBulkWrite *g = &group;
+  return submit([=](PortHandler *) { return g->txPacket(); }, callback, arg);
+}
+
+#endif
@@ -0,0 +1,318 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include "bus_scanner.h"
+#include "group_sync_read.h"
+#elif defined(__APPLE__)
+#include "bus_scanner.h"
+#include "group_sync_read.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "bus_scanner.h"
+#include "group_sync_read.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/bus_scanner.h"
+#include "../../include/dynamixel_sdk/group_sync_read.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+///////////////// Control table addresses common to the Dynamixels of each protocol /////////////////
+#define ADDR_MODEL_NUMBER           0
+#define ADDR_FIRMWARE_VERSION_1     2   // Protocol 1.0
+#define ADDR_FIRMWARE_VERSION_2     6   // Protocol 2.0
+
+using namespace dynamixel;
+
+BusScanner::BusScanner(PortHandler *port)
+  : port_(port),
+    callback_(0),
+    arg_(0),
+    is_aborted_(false),
+    protocol1_(true),
+    protocol2_(true),
+    first_id_(0),
+    last_id_(MAX_ID),
+    idle_time_(0.0)
+{
+}
+
+void BusScanner::setIdRange(uint8_t first_id, uint8_t last_id)
+{
+  first_id_ = first_id;
+  last_id_  = (last_id > MAX_ID) ? MAX_ID : last_id;
+}
+
+void BusScanner::addDevice(uint8_t id, uint16_t model_number, uint8_t firmware_version, float protocol_version, int baudrate)
+{
+  Device device;
+  device.id               = id;
+  device.model_number     = model_number;
+  device.firmware_version = firmware_version;
+  device.protocol_version = protocol_version;
+  device.baudrate         = baudrate;
+  device_list_.push_back(device);
+}
+
+bool BusScanner::step(const Device *device)
+{
+  if (callback_ != 0 && callback_(this, device, arg_) == false)
+    is_aborted_ = true;
+
+  return (is_aborted_ == false);
+}
+
+int BusScanner::scan()
+{
+  int baudrate = port_->getBaudRate();
+  int count    = 0;
+
+  device_list_.clear();
+
+  if (baudrate_list_.empty() == true)
+  {
+    count = scan(baudrate);
+    return (count < 0) ? 0 : count;
+  }
+
+  for (unsigned int i = 0; i < baudrate_list_.size(); i++)
+  {
+    int result = scan(baudrate_list_[i]);
+    if (result > 0)
+      count += result;
+    if (is_aborted_ == true)
+      break;
+  }
+
+  if (port_->getBaudRate() != baudrate)
+    port_->setBaudRate(baudrate);
+
+  return count;
+}
+
+int BusScanner::scan(int baudrate)
+{
+  int     count = 0;
+  uint8_t dxl_error;
+  uint8_t dxl_firmware;
+  uint16_t dxl_model_num;
+
+  is_aborted_ = false;
+
+  if (port_->getBaudRate() != baudrate && port_->setBaudRate(baudrate) == false)
+    return -1;
+
+  // the response times of the other baudrates do not fit this one
+  ResponseTimeEstimator *estimator = port_->getResponseTimeEstimator();
+  estimator_.clear();
+  port_->setResponseTimeEstimator(&estimator_);
+
+  if (protocol2_ == true)
+  {
+    PacketHandler *packet_handler = PacketHandler::getPacketHandler(2.0);
+    std::vector<uint8_t> id_list;
+
+    packet_handler->broadcastPing(port_, id_list, idle_time_);
+    bool is_running = step(0);
+    for (unsigned int i = 0; i < id_list.size() && is_running == true; i++)
+    {
+      if (id_list[i] < first_id_ || id_list[i] > last_id_)
+        continue;
+
+      if (packet_handler->ping(port_, id_list[i], &dxl_model_num, &dxl_error) == COMM_SUCCESS &&
+          packet_handler->read1ByteTxRx(port_, id_list[i], ADDR_FIRMWARE_VERSION_2, &dxl_firmware, &dxl_error) == COMM_SUCCESS)
+      {
+        addDevice(id_list[i], dxl_model_num, dxl_firmware, 2.0, baudrate);
+        count++;
+        is_running = step(&device_list_.back());
+      }
+      else
+      {
+        is_running = step(0);
+      }
+    }
+  }
+
+  if (protocol1_ == true && is_aborted_ == false)
+  {
+    PacketHandler *packet_handler = PacketHandler::getPacketHandler(1.0);
+    bool is_running = true;
+
+    for (int id = first_id_; id <= last_id_ && is_running == true; id++)
+    {
+      if (packet_handler->ping(port_, id, &dxl_model_num, &dxl_error) == COMM_SUCCESS &&
+          packet_handler->read1ByteTxRx(port_, id, ADDR_FIRMWARE_VERSION_1, &dxl_firmware, &dxl_error) == COMM_SUCCESS)
+      {
+        addDevice(id, dxl_model_num, dxl_firmware, 1.0, baudrate);
+        count++;
+        is_running = step(&device_list_.back());
+      }
+      else
+      {
+        is_running = step(0);
+      }
+    }
+  }
+
+  port_->setResponseTimeEstimator(estimator);
+
+  return count;
+}
+
+bool BusScanner::verifyDevices(unsigned int begin, unsigned int end)
+{
+  int     baudrate  = device_list_[begin].baudrate;
+  uint8_t dxl_error = 0;
+
+  if (port_->getBaudRate() != baudrate && port_->setBaudRate(baudrate) == false)
+    return false;
+
+  if (device_list_[begin].protocol_version == 2.0)
+  {
+    // model number at 0 and firmware version at 6 in one status packet per Dynamixel
+    GroupSyncRead group_sync_read(port_, PacketHandler::getPacketHandler(2.0), ADDR_MODEL_NUMBER, ADDR_FIRMWARE_VERSION_2 + 1);
+
+    for (unsigned int i = begin; i < end; i++)
+    {
+      if (group_sync_read.addParam(device_list_[i].id) == false)
+        return false;
+    }
+
+    if (group_sync_read.txRxPacket() != COMM_SUCCESS)
+      return false;
+
+    for (unsigned int i = begin; i < end; i++)
+    {
+      if (group_sync_read.getData(device_list_[i].id, ADDR_MODEL_NUMBER, 2) != device_list_[i].model_number ||
+          group_sync_read.getData(device_list_[i].id, ADDR_FIRMWARE_VERSION_2, 1) != device_list_[i].firmware_version)
+        return false;
+    }
+  }
+  else
+  {
+    PacketHandler *packet_handler = PacketHandler::getPacketHandler(1.0);
+    uint8_t data[ADDR_FIRMWARE_VERSION_1 + 1];
+
+    for (unsigned int i = begin; i < end; i++)
+    {
+      if (packet_handler->readTxRx(port_, device_list_[i].id, ADDR_MODEL_NUMBER, ADDR_FIRMWARE_VERSION_1 + 1, data, &dxl_error) != COMM_SUCCESS)
+        return false;
+
+      if (DXL_MAKEWORD(data[0], data[1]) != device_list_[i].model_number || data[ADDR_FIRMWARE_VERSION_1] != device_list_[i].firmware_version)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool BusScanner::verifyDeviceList()
+{
+  int   baudrate  = port_->getBaudRate();
+  bool  result    = (device_list_.empty() == false);
+
+  // one transaction for each run of the Dynamixels with the same baudrate and protocol
+  for (unsigned int begin = 0; begin < device_list_.size() && result == true; )
+  {
+    unsigned int end = begin + 1;
+    while (end < device_list_.size() &&
+           device_list_[end].baudrate == device_list_[begin].baudrate &&
+           device_list_[end].protocol_version == device_list_[begin].protocol_version)
+      end++;
+
+    result = verifyDevices(begin, end);
+    begin = end;
+  }
+
+  if (port_->getBaudRate() != baudrate)
+    port_->setBaudRate(baudrate);
+
+  return result;
+}
+
+bool BusScanner::saveDeviceList(const char *file_name)
+{
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  return false;
+#else
+  FILE *file = fopen(file_name, "w");
+  if (file == NULL)
+    return false;
+
+  fprintf(file, "# port baudrate protocol id model_number firmware_version\n");
+  for (unsigned int i = 0; i < device_list_.size(); i++)
+  {
+    fprintf(file, "%s %d %.1f %d %d %d\n", port_->getPortName(), device_list_[i].baudrate, device_list_[i].protocol_version,
+            device_list_[i].id, device_list_[i].model_number, device_list_[i].firmware_version);
+  }
+
+  bool result = (ferror(file) == 0);
+  fclose(file);
+  return result;
+#endif
+}
+
+bool BusScanner::loadDeviceList(const char *file_name)
+{
+  device_list_.clear();
+
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  return false;
+#else
+  FILE *file = fopen(file_name, "r");
+  if (file == NULL)
+    return false;
+
+  char  line[256];
+  char  port_name[100];
+  int   baudrate, id, model_number, firmware_version;
+  float protocol_version;
+  bool  result = true;
+
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    if (line[0] == '#' || line[0] == '\n')
+      continue;
+
+    if (sscanf(line, "%99s %d %f %d %d %d", port_name, &baudrate, &protocol_version, &id, &model_number, &firmware_version) != 6 ||
+        strcmp(port_name, port_->getPortName()) != 0 || id < 0 || id > MAX_ID)
+    {
+      result = false;
+      break;
+    }
+
+    addDevice((uint8_t)id, (uint16_t)model_number, (uint8_t)firmware_version, protocol_version, baudrate);
+  }
+  fclose(file);
+
+  if (result == false)
+    device_list_.clear();
+  return result;
+#endif
+}
+
+int BusScanner::scanWithCache(const char *file_name)
+{
+  if (loadDeviceList(file_name) == true && verifyDeviceList() == true)
+    return (int)device_list_.size();
+
+  scan();
+  if (is_aborted_ == false)
+    saveDeviceList(file_name);
+  return (int)device_list_.size();
+}
@@ -0,0 +1,271 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include <time.h>
+#include "control_loop.h"
+#elif defined(__APPLE__)
+#include <time.h>
+#include <mach/mach_time.h>
+#include "control_loop.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include <windows.h>
+#include <mmsystem.h>
+#include "control_loop.h"
+#pragma comment(lib, "winmm.lib")
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include <Arduino.h>
+#include "../../include/dynamixel_sdk/control_loop.h"
+#endif
+
+#include <algorithm>
+#include <stdio.h>
+
+using namespace dynamixel;
+
+// monotonic time in nsec
+static int64_t getMonotonicTime()
+{
+#if defined(__linux__)
+  struct timespec tv;
+  clock_gettime(CLOCK_MONOTONIC, &tv);
+  return (int64_t)tv.tv_sec * 1000000000 + (int64_t)tv.tv_nsec;
+#elif defined(__APPLE__)
+  static mach_timebase_info_data_t timebase;
+  if (timebase.denom == 0)
+    mach_timebase_info(&timebase);
+  return (int64_t)(mach_absolute_time() * timebase.numer / timebase.denom);
+#elif defined(_WIN32) || defined(_WIN64)
+  LARGE_INTEGER counter, frequency;
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (int64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  return (int64_t)micros() * 1000;
+#endif
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// the timer on which a thread sleeps, and the time before the deadline at which it wakes up to spin the rest
+class WaitableTimer
+{
+ public:
+  HANDLE  handle;
+  int64_t margin;   // nsec
+
+  WaitableTimer()
+  {
+    // Windows 10 1803 or later: the timer is not bound to the tick of the system clock
+    handle = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    margin = 200000;
+    if (handle == NULL)
+    {
+      // older Windows: the tick of 15.6 msec is shortened to 1 msec for the process
+      timeBeginPeriod(1);
+      handle = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+      margin = 1500000;
+    }
+  }
+
+  ~WaitableTimer()
+  {
+    if (handle != NULL)
+      CloseHandle(handle);
+  }
+};
+#endif
+
+static void sleepUntil(int64_t deadline)
+{
+#if defined(__linux__)
+  struct timespec tv;
+  tv.tv_sec  = deadline / 1000000000;
+  tv.tv_nsec = deadline % 1000000000;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tv, NULL) != 0)  // EINTR
+    ;
+#elif defined(__APPLE__)
+  int64_t remaining_time;
+  while ((remaining_time = deadline - getMonotonicTime()) > 0)
+  {
+    struct timespec tv;
+    tv.tv_sec  = remaining_time / 1000000000;
+    tv.tv_nsec = remaining_time % 1000000000;
+    nanosleep(&tv, NULL);
+  }
+#elif defined(_WIN32) || defined(_WIN64)
+  static thread_local WaitableTimer timer;   // each thread which runs a loop has its own timer
+
+  int64_t remaining_time = deadline - getMonotonicTime();
+  if (timer.handle != NULL && remaining_time > timer.margin)
+  {
+    LARGE_INTEGER due_time;
+    due_time.QuadPart = -(remaining_time - timer.margin) / 100;   // relative time in 100 nsec
+    if (SetWaitableTimer(timer.handle, &due_time, 0, NULL, NULL, FALSE) != 0)
+      WaitForSingleObject(timer.handle, INFINITE);
+  }
+
+  // only the margin of the timer is spent spinning
+  while (deadline - getMonotonicTime() > 0)
+    YieldProcessor();
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  int64_t remaining_time = deadline - getMonotonicTime();
+  if (remaining_time > 0)
+    delayMicroseconds((unsigned int)(remaining_time / 1000));
+#endif
+}
+
+ControlLoop::ControlLoop(CyclePlan *plan, double rate)
+  : plan_(plan),
+    callback_(0),
+    arg_(0),
+    period_(0),
+    deadline_(0),
+    is_stopping_(false),
+    bin_width_(10.0)
+{
+  setRate(rate);
+  setHistogram(10.0, 50);
+}
+
+void ControlLoop::setRate(double rate)
+{
+  period_   = (int64_t)(1000000000.0 / rate);
+  deadline_ = 0;
+}
+
+void ControlLoop::setHistogram(double bin_width, int bin_count)
+{
+  bin_width_ = bin_width;
+  jitter_histogram_.assign(bin_count, 0);
+  cycle_time_histogram_.assign(bin_count, 0);
+  clearStatistics();
+}
+
+void ControlLoop::clearStatistics()
+{
+  std::fill(jitter_histogram_.begin(), jitter_histogram_.end(), 0);
+  std::fill(cycle_time_histogram_.begin(), cycle_time_histogram_.end(), 0);
+
+  cycle_count_    = 0;
+  overrun_count_  = 0;
+  missed_count_   = 0;
+  max_jitter_     = 0.0;
+  sum_jitter_     = 0.0;
+  max_cycle_time_ = 0.0;
+  sum_cycle_time_ = 0.0;
+  deadline_       = 0;
+}
+
+bool ControlLoop::checkRate()
+{
+  if (plan_ == 0)
+    return true;
+
+  if (plan_->getCycleTime() > getPeriod())
+  {
+    printf("[ControlLoop::checkRate] The estimated cycle time %.3f msec is longer than the period %.3f msec!\n", plan_->getCycleTime(), getPeriod());
+    return false;
+  }
+
+  return true;
+}
+
+bool ControlLoop::spinOnce()
+{
+  int64_t now = getMonotonicTime();
+  if (deadline_ == 0)
+    deadline_ = now;
+  else
+    sleepUntil(deadline_);
+
+  int64_t start = getMonotonicTime();
+  int     result = COMM_SUCCESS;
+
+  if (plan_ != 0)
+    result = plan_->txRxPacket();
+  if (callback_ != 0)
+    callback_(this, result, arg_);
+
+  int64_t end = getMonotonicTime();
+
+  double jitter     = (start - deadline_) / 1000.0;
+  double cycle_time = (end - start) / 1000.0;
+  int    last       = (int)jitter_histogram_.size() - 1;
+
+  if (last >= 0)
+  {
+    int bin = (int)(jitter / bin_width_);
+    jitter_histogram_[(bin < last) ? bin : last]++;
+
+    bin = (int)((end - start) * (last + 1) / period_);
+    cycle_time_histogram_[(bin < last) ? bin : last]++;
+  }
+
+  cycle_count_++;
+  sum_jitter_     += jitter;
+  sum_cycle_time_ += cycle_time;
+  if (jitter > max_jitter_)
+    max_jitter_ = jitter;
+  if (cycle_time > max_cycle_time_)
+    max_cycle_time_ = cycle_time;
+
+  // the deadlines which already passed are skipped instead of running the cycles back to back
+  deadline_ += period_;
+  if (end <= deadline_)
+    return true;
+
+  int64_t missed = (end - deadline_) / period_;
+  deadline_ += (missed + 1) * period_;
+  missed_count_ += (unsigned long)missed + 1;
+  overrun_count_++;
+  return false;
+}
+
+bool ControlLoop::takeStop()
+{
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  bool is_stopping = is_stopping_;
+  is_stopping_ = false;
+  return is_stopping;
+#else
+  return is_stopping_.exchange(false);
+#endif
+}
+
+unsigned long ControlLoop::run(unsigned long cycles)
+{
+  unsigned long count   = 0;
+  unsigned long overrun = overrun_count_;
+
+  checkRate();
+
+  // the stop is taken only when it ends the loop, so a stop which comes after the last cycle is kept for the next run
+  while ((cycles == 0 || count < cycles) && takeStop() == false)
+  {
+    spinOnce();
+    count++;
+  }
+
+  if (overrun_count_ > overrun)
+    printf("[ControlLoop::run] %lu of %lu cycles overran the period %.3f msec!\n", overrun_count_ - overrun, count, getPeriod());
+
+  return count;
+}
@@ -0,0 +1,635 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <stdio.h>
+
+#if defined(__linux__)
+#include "cycle_plan.h"
+#elif defined(__APPLE__)
+#include "cycle_plan.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "cycle_plan.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/cycle_plan.h"
+#endif
+
+///////////////// Packet sizes in bytes, without the parameters /////////////////
+#define INST_PACKET_SIZE_1          6   // Protocol 1.0 : HEADER0 HEADER1 ID LENGTH INST CHKSUM
+#define STATUS_PACKET_SIZE_1        6   // Protocol 1.0 : HEADER0 HEADER1 ID LENGTH ERROR CHKSUM
+#define INST_PACKET_SIZE_2          10  // Protocol 2.0 : HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST CRC16_L CRC16_H
+#define STATUS_PACKET_SIZE_2        11  // Protocol 2.0 : HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST ERROR CRC16_L CRC16_H
+#define FAST_STATUS_PACKET_SIZE     8   // Protocol 2.0 : HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST, and ERROR ID DATA CRC16 for each
+
+using namespace dynamixel;
+
+CyclePlan::CyclePlan(PortHandler *port, PacketHandler *ph)
+  : port_(port),
+    ph_(ph),
+    last_result_(false),
+    is_param_changed_(false),
+    is_fast_read_(false),
+    is_indirect_(false),
+    indirect_address_(0),
+    indirect_data_(0),
+    indirect_length_(0),
+    return_delay_time_(500.0),
+    cycle_time_(0.0),
+    read_type_(READ_NONE),
+    group_sync_read_(0),
+    group_bulk_read_(0),
+    group_indirect_sync_read_(0)
+{
+}
+
+CyclePlan::~CyclePlan()
+{
+  releaseGroups();
+}
+
+void CyclePlan::releaseGroups()
+{
+  if (group_sync_read_ != 0)
+    delete group_sync_read_;
+  if (group_bulk_read_ != 0)
+    delete group_bulk_read_;
+  if (group_indirect_sync_read_ != 0)
+    delete group_indirect_sync_read_;
+  group_sync_read_          = 0;
+  group_bulk_read_          = 0;
+  group_indirect_sync_read_ = 0;
+
+  for (unsigned int i = 0; i < write_group_list_.size(); i++)
+  {
+    if (write_group_list_[i].sync_write != 0)
+      delete write_group_list_[i].sync_write;
+    if (write_group_list_[i].bulk_write != 0)
+      delete write_group_list_[i].bulk_write;
+  }
+  write_group_list_.clear();
+
+  read_type_    = READ_NONE;
+  last_result_  = false;
+  cycle_time_   = 0.0;
+}
+
+void CyclePlan::setIndirectAddress(uint16_t indirect_address, uint16_t indirect_data, uint16_t max_length)
+{
+  is_indirect_      = (max_length > 0);
+  indirect_address_ = indirect_address;
+  indirect_data_    = indirect_data;
+  indirect_length_  = max_length;
+  is_param_changed_ = true;
+}
+
+bool CyclePlan::addRead(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (id >= BROADCAST_ID || data_length == 0)
+    return false;
+
+  Register item;
+  item.id       = id;
+  item.address  = address;
+  item.length   = data_length;
+  read_list_.push_back(item);
+
+  is_param_changed_ = true;
+  return true;
+}
+
+bool CyclePlan::addWrite(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (id >= BROADCAST_ID || data_length == 0)
+    return false;
+
+  // the registers which overlap or touch are written as one, so that no byte out of them is written
+  Span span;
+  span.id       = id;
+  span.address  = address;
+  span.length   = data_length;
+  span.error    = 0;
+
+  int begin = address;
+  int end   = address + data_length;
+  for (unsigned int i = 0; i < write_span_list_.size(); i++)
+  {
+    if (write_span_list_[i].id == id && write_span_list_[i].address <= end && begin <= write_span_list_[i].address + write_span_list_[i].length)
+    {
+      begin = std::min(begin, (int)write_span_list_[i].address);
+      end   = std::max(end, write_span_list_[i].address + write_span_list_[i].length);
+    }
+  }
+  span.address  = (uint16_t)begin;
+  span.length   = (uint16_t)(end - begin);
+  span.data.assign(span.length, 0);
+
+  for (unsigned int i = 0; i < write_span_list_.size(); )
+  {
+    if (write_span_list_[i].id == id && begin <= write_span_list_[i].address && write_span_list_[i].address + write_span_list_[i].length <= end)
+    {
+      std::copy(write_span_list_[i].data.begin(), write_span_list_[i].data.end(), span.data.begin() + (write_span_list_[i].address - begin));
+      write_span_list_.erase(write_span_list_.begin() + i);
+    }
+    else
+    {
+      i++;
+    }
+  }
+  write_span_list_.push_back(span);
+
+  is_param_changed_ = true;
+  return true;
+}
+
+void CyclePlan::clearParam()
+{
+  releaseGroups();
+  read_list_.clear();
+  read_span_list_.clear();
+  write_span_list_.clear();
+  is_param_changed_ = true;
+}
+
+double CyclePlan::getWireTime(int bytes, int status_packets)
+{
+  // 10 bits for each byte
+  return (double)bytes * 10.0 * 1000.0 / port_->getBaudRate() + status_packets * return_delay_time_ / 1000.0;
+}
+
+int CyclePlan::planReads()
+{
+  read_span_list_.clear();
+  if (read_list_.empty() == true)
+    return COMM_SUCCESS;
+
+  // the span of each ID and the registers of it without overlaps for the indirect data
+  std::vector<std::vector<std::pair<int, int> > > merged_list;
+  for (unsigned int i = 0; i < read_list_.size(); i++)
+  {
+    unsigned int s = 0;
+    while (s < read_span_list_.size() && read_span_list_[s].id != read_list_[i].id)
+      s++;
+
+    int begin = read_list_[i].address;
+    int end   = read_list_[i].address + read_list_[i].length;
+    if (s == read_span_list_.size())
+    {
+      Span span;
+      span.id       = read_list_[i].id;
+      span.address  = (uint16_t)begin;
+      span.length   = (uint16_t)(end - begin);
+      span.error    = 0;
+      read_span_list_.push_back(span);
+      merged_list.push_back(std::vector<std::pair<int, int> >());
+    }
+    else
+    {
+      int span_end = read_span_list_[s].address + read_span_list_[s].length;
+      read_span_list_[s].address  = (uint16_t)std::min(begin, (int)read_span_list_[s].address);
+      read_span_list_[s].length   = (uint16_t)(std::max(end, span_end) - read_span_list_[s].address);
+    }
+    merged_list[s].push_back(std::make_pair(begin, end));
+  }
+
+  int n = (int)read_span_list_.size();
+
+  if (ph_->getProtocolVersion() == 1.0)
+  {
+    // a Read for each Dynamixel
+    for (int i = 0; i < n; i++)
+    {
+      read_span_list_[i].data.assign(read_span_list_[i].length, 0);
+      cycle_time_ += getWireTime(INST_PACKET_SIZE_1 + 2 + STATUS_PACKET_SIZE_1 + read_span_list_[i].length, 1);
+    }
+    read_type_ = READ_EACH;
+    return COMM_SUCCESS;
+  }
+
+  int sync_begin = 0xFFFF, sync_end = 0, bulk_status = 0, bulk_fast_status = 0, indirect_length = 0;
+  bool is_indirect = is_indirect_;
+  for (int i = 0; i < n; i++)
+  {
+    Span &span = read_span_list_[i];
+    sync_begin        = std::min(sync_begin, (int)span.address);
+    sync_end          = std::max(sync_end, span.address + span.length);
+    bulk_status      += STATUS_PACKET_SIZE_2 + span.length;
+    bulk_fast_status += 4 + span.length;
+
+    std::vector<std::pair<int, int> > &merged = merged_list[i];
+    std::sort(merged.begin(), merged.end());
+    int length = 0, begin = -1, end = -1;
+    for (unsigned int j = 0; j < merged.size(); j++)
+    {
+      if (merged[j].first > end)
+      {
+        length += end - begin;
+        begin   = merged[j].first;
+      }
+      end = std::max(end, merged[j].second);
+    }
+    length += end - begin;
+    indirect_length = std::max(indirect_length, length);
+    if (length > indirect_length_)
+      is_indirect = false;
+  }
+
+  int    sync_length  = sync_end - sync_begin;
+  int    packets      = (is_fast_read_ == true) ? 1 : n;
+  double sync_time, bulk_time, indirect_time;
+
+  if (is_fast_read_ == true)
+  {
+    sync_time     = getWireTime(INST_PACKET_SIZE_2 + 4 + n + FAST_STATUS_PACKET_SIZE + n * (4 + sync_length), packets);
+    bulk_time     = getWireTime(INST_PACKET_SIZE_2 + 5 * n + FAST_STATUS_PACKET_SIZE + bulk_fast_status, packets);
+    indirect_time = getWireTime(INST_PACKET_SIZE_2 + 4 + n + FAST_STATUS_PACKET_SIZE + n * (4 + indirect_length), packets);
+  }
+  else
+  {
+    sync_time     = getWireTime(INST_PACKET_SIZE_2 + 4 + n + n * (STATUS_PACKET_SIZE_2 + sync_length), packets);
+    bulk_time     = getWireTime(INST_PACKET_SIZE_2 + 5 * n + bulk_status, packets);
+    indirect_time = getWireTime(INST_PACKET_SIZE_2 + 4 + n + n * (STATUS_PACKET_SIZE_2 + indirect_length), packets);
+  }
+
+  if (is_indirect == true && indirect_time < sync_time && indirect_time < bulk_time)
+  {
+    group_indirect_sync_read_ = new GroupIndirectSyncRead(port_, ph_, indirect_address_, indirect_data_, indirect_length_);
+    group_indirect_sync_read_->setFastRead(is_fast_read_);
+
+    for (int i = 0; i < n; i++)
+    {
+      std::vector<std::pair<int, int> > &merged = merged_list[i];
+      int begin = merged[0].first, end = merged[0].second;
+      for (unsigned int j = 1; j <= merged.size(); j++)
+      {
+        if (j == merged.size() || merged[j].first > end)
+        {
+          group_indirect_sync_read_->addParam(read_span_list_[i].id, (uint16_t)begin, (uint16_t)(end - begin));
+          if (j == merged.size())
+            break;
+          begin = merged[j].first;
+        }
+        end = std::max(end, merged[j].second);
+      }
+    }
+
+    // the indirect addresses are written while the torque is disabled
+    uint8_t dxl_error = 0;
+    for (int i = 0; i < n && dxl_error == 0; i++)
+    {
+      int result = group_indirect_sync_read_->writeIndirectAddress(read_span_list_[i].id, &dxl_error);
+      if (result != COMM_SUCCESS)
+        return result;
+    }
+
+    if (dxl_error == 0)
+    {
+      read_type_ = READ_INDIRECT;
+      cycle_time_ += indirect_time;
+      return COMM_SUCCESS;
+    }
+
+    // a Dynamixel refused the indirect addresses (ex. the torque is enabled), so the old table would be read
+    printf("[CyclePlan::compile] %s Sync Read or Bulk Read is used instead of Indirect Sync Read.\n", ph_->getRxPacketError(dxl_error));
+    delete group_indirect_sync_read_;
+    group_indirect_sync_read_ = 0;
+  }
+
+  if (bulk_time < sync_time)
+  {
+    read_type_ = READ_BULK;
+    cycle_time_ += bulk_time;
+    group_bulk_read_ = new GroupBulkRead(port_, ph_);
+    group_bulk_read_->setFastRead(is_fast_read_);
+    for (int i = 0; i < n; i++)
+      group_bulk_read_->addParam(read_span_list_[i].id, read_span_list_[i].address, read_span_list_[i].length);
+  }
+  else
+  {
+    read_type_ = READ_SYNC;
+    cycle_time_ += sync_time;
+    group_sync_read_ = new GroupSyncRead(port_, ph_, (uint16_t)sync_begin, (uint16_t)sync_length);
+    group_sync_read_->setFastRead(is_fast_read_);
+    for (int i = 0; i < n; i++)
+      group_sync_read_->addParam(read_span_list_[i].id);
+  }
+
+  return COMM_SUCCESS;
+}
+
+void CyclePlan::planWrites()
+{
+  if (write_span_list_.empty() == true)
+    return;
+
+  double  protocol_version = ph_->getProtocolVersion();
+  int     sync_header      = (protocol_version == 1.0) ? (INST_PACKET_SIZE_1 + 2) : (INST_PACKET_SIZE_2 + 4);
+
+  // the spans of the same address and length can share a Sync Write
+  std::vector<std::vector<int> > sync_list;
+  for (unsigned int i = 0; i < write_span_list_.size(); i++)
+  {
+    unsigned int g = 0;
+    while (g < sync_list.size() &&
+           (write_span_list_[sync_list[g][0]].address != write_span_list_[i].address ||
+            write_span_list_[sync_list[g][0]].length != write_span_list_[i].length))
+      g++;
+
+    if (g == sync_list.size())
+      sync_list.push_back(std::vector<int>());
+    sync_list[g].push_back(i);
+  }
+
+  // the Sync Writes of one Dynamixel can be put together into Bulk Writes, each of them with one span of each ID
+  std::vector<int> bulk_list;
+  int sync_bytes = 0, shared_bytes = 0, bulk_bytes = 0;
+  for (unsigned int g = 0; g < sync_list.size(); g++)
+  {
+    int length    = write_span_list_[sync_list[g][0]].length;
+    int bytes     = sync_header + (int)sync_list[g].size() * (1 + length);
+    sync_bytes   += bytes;
+    bulk_bytes   += (int)sync_list[g].size() * (5 + length);
+    if (sync_list[g].size() > 1)
+      shared_bytes += bytes;
+    else
+      bulk_list.push_back(sync_list[g][0]);
+  }
+
+  std::vector<int> bulk_count(BROADCAST_ID, 0);
+  int rounds = 0;
+  for (unsigned int i = 0; i < write_span_list_.size(); i++)
+    rounds = std::max(rounds, ++bulk_count[write_span_list_[i].id]);
+  bulk_bytes += rounds * INST_PACKET_SIZE_2;
+
+  std::fill(bulk_count.begin(), bulk_count.end(), 0);
+  int shared_rounds = 0;
+  for (unsigned int i = 0; i < bulk_list.size(); i++)
+  {
+    shared_rounds = std::max(shared_rounds, ++bulk_count[write_span_list_[bulk_list[i]].id]);
+    shared_bytes += 5 + write_span_list_[bulk_list[i]].length;
+  }
+  shared_bytes += shared_rounds * INST_PACKET_SIZE_2;
+
+  // Protocol 1.0 has no Bulk Write
+  if (protocol_version == 1.0 || (sync_bytes <= shared_bytes && sync_bytes <= bulk_bytes))
+  {
+    bulk_list.clear();
+    cycle_time_ += getWireTime(sync_bytes, 0);
+  }
+  else if (shared_bytes <= bulk_bytes)
+  {
+    for (unsigned int g = 0; g < sync_list.size(); )
+    {
+      if (sync_list[g].size() == 1)
+        sync_list.erase(sync_list.begin() + g);
+      else
+        g++;
+    }
+    cycle_time_ += getWireTime(shared_bytes, 0);
+  }
+  else
+  {
+    sync_list.clear();
+    bulk_list.clear();
+    for (unsigned int i = 0; i < write_span_list_.size(); i++)
+      bulk_list.push_back(i);
+    cycle_time_ += getWireTime(bulk_bytes, 0);
+  }
+
+  for (unsigned int g = 0; g < sync_list.size(); g++)
+  {
+    Span &first = write_span_list_[sync_list[g][0]];
+    WriteGroup group;
+    group.sync_write  = new GroupSyncWrite(port_, ph_, first.address, first.length);
+    group.bulk_write  = 0;
+    group.span_list   = sync_list[g];
+    for (unsigned int j = 0; j < group.span_list.size(); j++)
+    {
+      Span &span = write_span_list_[group.span_list[j]];
+      group.sync_write->addParam(span.id, &span.data[0]);
+    }
+    write_group_list_.push_back(group);
+  }
+
+  // a Bulk Write for each round of the remaining spans
+  std::fill(bulk_count.begin(), bulk_count.end(), 0);
+  for (unsigned int i = 0; i < bulk_list.size(); i++)
+  {
+    Span &span  = write_span_list_[bulk_list[i]];
+    int   round = bulk_count[span.id]++;
+    unsigned int g = 0, r = 0;
+    while (g < write_group_list_.size() && (write_group_list_[g].bulk_write == 0 || r++ != (unsigned int)round))
+      g++;
+
+    if (g == write_group_list_.size())
+    {
+      WriteGroup group;
+      group.sync_write  = 0;
+      group.bulk_write  = new GroupBulkWrite(port_, ph_);
+      write_group_list_.push_back(group);
+    }
+    write_group_list_[g].span_list.push_back(bulk_list[i]);
+    write_group_list_[g].bulk_write->addParam(span.id, span.address, span.length, &span.data[0]);
+  }
+}
+
+int CyclePlan::compile()
+{
+  releaseGroups();
+  is_param_changed_ = false;
+
+  if (read_list_.empty() == true && write_span_list_.empty() == true)
+    return COMM_NOT_AVAILABLE;
+
+  planWrites();
+  int result = planReads();
+  if (result != COMM_SUCCESS)
+    is_param_changed_ = true;
+
+  return result;
+}
+
+CyclePlan::Span *CyclePlan::findSpan(std::vector<Span> &span_list, uint8_t id, uint16_t address, uint16_t data_length)
+{
+  for (unsigned int i = 0; i < span_list.size(); i++)
+  {
+    if (span_list[i].id == id && span_list[i].address <= address && address + data_length <= span_list[i].address + span_list[i].length)
+      return &span_list[i];
+  }
+  return 0;
+}
+
+bool CyclePlan::setData(uint8_t id, uint16_t address, uint16_t data_length, uint32_t data)
+{
+  Span *span = findSpan(write_span_list_, id, address, data_length);
+  if (span == 0 || (data_length != 1 && data_length != 2 && data_length != 4))
+    return false;
+
+  for (uint16_t i = 0; i < data_length; i++)
+    span->data[address - span->address + i] = (uint8_t)(data >> (8 * i));
+
+  return true;
+}
+
+int CyclePlan::txRxPacket()
+{
+  int result = COMM_SUCCESS;
+
+  if (is_param_changed_ == true)
+  {
+    result = compile();
+    if (result != COMM_SUCCESS)
+      return result;
+  }
+
+  last_result_ = false;
+
+  for (unsigned int g = 0; g < write_group_list_.size(); g++)
+  {
+    WriteGroup &group = write_group_list_[g];
+    for (unsigned int j = 0; j < group.span_list.size(); j++)
+    {
+      Span &span = write_span_list_[group.span_list[j]];
+      if (group.sync_write != 0)
+        group.sync_write->changeParam(span.id, &span.data[0]);
+      else
+        group.bulk_write->changeParam(span.id, span.address, span.length, &span.data[0]);
+    }
+
+    result = (group.sync_write != 0) ? group.sync_write->txPacket() : group.bulk_write->txPacket();
+    if (result != COMM_SUCCESS)
+      return result;
+  }
+
+  switch (read_type_)
+  {
+    case READ_SYNC:
+      result = group_sync_read_->txRxPacket();
+      break;
+
+    case READ_BULK:
+      result = group_bulk_read_->txRxPacket();
+      break;
+
+    case READ_INDIRECT:
+      result = group_indirect_sync_read_->txRxPacket();
+      break;
+
+    case READ_EACH:
+      for (unsigned int i = 0; i < read_span_list_.size() && result == COMM_SUCCESS; i++)
+      {
+        Span &span = read_span_list_[i];
+        result = ph_->readTxRx(port_, span.id, span.address, span.length, &span.data[0], &span.error);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  if (result == COMM_SUCCESS)
+    last_result_ = true;
+
+  return result;
+}
+
+bool CyclePlan::isAvailable(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (last_result_ == false || findSpan(read_span_list_, id, address, data_length) == 0)
+    return false;
+
+  switch (read_type_)
+  {
+    case READ_SYNC:
+      return group_sync_read_->isAvailable(id, address, data_length);
+
+    case READ_BULK:
+      return group_bulk_read_->isAvailable(id, address, data_length);
+
+    case READ_INDIRECT:
+      return group_indirect_sync_read_->isAvailable(id, address, data_length);
+
+    case READ_EACH:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+uint32_t CyclePlan::getData(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (isAvailable(id, address, data_length) == false)
+    return 0;
+
+  switch (read_type_)
+  {
+    case READ_SYNC:
+      return group_sync_read_->getData(id, address, data_length);
+
+    case READ_BULK:
+      return group_bulk_read_->getData(id, address, data_length);
+
+    case READ_INDIRECT:
+      return group_indirect_sync_read_->getData(id, address, data_length);
+
+    default:
+      break;
+  }
+
+  Span          *span = findSpan(read_span_list_, id, address, data_length);
+  const uint8_t *data = &span->data[address - span->address];
+  switch (data_length)
+  {
+    case 1:
+      return data[0];
+
+    case 2:
+      return DXL_MAKEWORD(data[0], data[1]);
+
+    case 4:
+      return DXL_MAKEDWORD(DXL_MAKEWORD(data[0], data[1]), DXL_MAKEWORD(data[2], data[3]));
+
+    default:
+      return 0;
+  }
+}
+
+bool CyclePlan::getError(uint8_t id, uint8_t* error)
+{
+  switch (read_type_)
+  {
+    case READ_SYNC:
+      return group_sync_read_->getError(id, error);
+
+    case READ_BULK:
+      return group_bulk_read_->getError(id, error);
+
+    case READ_INDIRECT:
+      return group_indirect_sync_read_->getError(id, error);
+
+    case READ_EACH:
+      for (unsigned int i = 0; i < read_span_list_.size(); i++)
+      {
+        if (read_span_list_[i].id == id)
+          return (error[0] = read_span_list_[i].error) != 0;
+      }
+      return false;
+
+    default:
+      return false;
+  }
+}
@@ -37,8 +37,11 @@ GroupBulkRead::GroupBulkRead(PortHandler *port, PacketHandler *ph)
     ph_(ph),
     last_result_(false),
     is_param_changed_(false),
+    is_fast_read_(false),
+    rx_index_(0),
     param_(0)
 {
+  std::fill(slot_list_, slot_list_ + 256, -1);
   clearParam();
 }
 
@@ -66,31 +69,33 @@ void GroupBulkRead::makeParam()
     uint8_t id = id_list_[i];
     if (ph_->getProtocolVersion() == 1.0)
     {
-      param_[idx++] = (uint8_t)length_list_[id];    // LEN
+      param_[idx++] = (uint8_t)length_list_[i];     // LEN
       param_[idx++] = id;                           // ID
-      param_[idx++] = (uint8_t)address_list_[id];   // ADDR
+      param_[idx++] = (uint8_t)address_list_[i];    // ADDR
     }
     else    // 2.0
     {
       param_[idx++] = id;                               // ID
-      param_[idx++] = DXL_LOBYTE(address_list_[id]);    // ADDR_L
-      param_[idx++] = DXL_HIBYTE(address_list_[id]);    // ADDR_H
-      param_[idx++] = DXL_LOBYTE(length_list_[id]);     // LEN_L
-      param_[idx++] = DXL_HIBYTE(length_list_[id]);     // LEN_H
+      param_[idx++] = DXL_LOBYTE(address_list_[i]);     // ADDR_L
+      param_[idx++] = DXL_HIBYTE(address_list_[i]);     // ADDR_H
+      param_[idx++] = DXL_LOBYTE(length_list_[i]);      // LEN_L
+      param_[idx++] = DXL_HIBYTE(length_list_[i]);      // LEN_H
     }
   }
 }
 
 bool GroupBulkRead::addParam(uint8_t id, uint16_t start_address, uint16_t data_length)
 {
-  if (std::find(id_list_.begin(), id_list_.end(), id) != id_list_.end())   // id already exist
+  if (slot_list_[id] >= 0)   // id already exist
     return false;
 
+  slot_list_[id] = (int16_t)id_list_.size();
   id_list_.push_back(id);
-  length_list_[id]    = data_length;
-  address_list_[id]   = start_address;
-  data_list_[id]      = new uint8_t[data_length];
-  error_list_[id]     = new uint8_t[1];
+  address_list_.push_back(start_address);
+  length_list_.push_back(data_length);
+  offset_list_.push_back((uint16_t)data_list_.size());
+  data_list_.resize(data_list_.size() + 4 + data_length);  // ERROR(1) + ID(1) + DATA(data_length) + CRC16(2)
+  data_list_[offset_list_.back() + 1] = id;
 
   is_param_changed_   = true;
   return true;
@@ -98,17 +103,22 @@ bool GroupBulkRead::addParam(uint8_t id, uint16_t start_address, uint16_t data_l
 
 void GroupBulkRead::removeParam(uint8_t id)
 {
-  std::vector<uint8_t>::iterator it = std::find(id_list_.begin(), id_list_.end(), id);
-  if (it == id_list_.end())    // NOT exist
+  int slot = slot_list_[id];
+  if (slot < 0)    // NOT exist
     return;
 
-  id_list_.erase(it);
-  address_list_.erase(id);
-  length_list_.erase(id);
-  delete[] data_list_[id];
-  delete[] error_list_[id];
-  data_list_.erase(id);
-  error_list_.erase(id);
+  uint16_t size = 4 + length_list_[slot];
+  data_list_.erase(data_list_.begin() + offset_list_[slot], data_list_.begin() + offset_list_[slot] + size);
+  id_list_.erase(id_list_.begin() + slot);
+  address_list_.erase(address_list_.begin() + slot);
+  length_list_.erase(length_list_.begin() + slot);
+  offset_list_.erase(offset_list_.begin() + slot);
+  slot_list_[id] = -1;
+  for (unsigned int i = slot; i < id_list_.size(); i++)
+  {
+    slot_list_[id_list_[i]] = (int16_t)i;
+    offset_list_[i]        -= size;
+  }
 
   is_param_changed_   = true;
 }
@@ -119,16 +129,13 @@ void GroupBulkRead::clearParam()
     return;
 
   for (unsigned int i = 0; i < id_list_.size(); i++)
-  {
-    delete[] data_list_[id_list_[i]];
-    delete[] error_list_[id_list_[i]];
-  }
+    slot_list_[id_list_[i]] = -1;
 
   id_list_.clear();
   address_list_.clear();
   length_list_.clear();
+  offset_list_.clear();
   data_list_.clear();
-  error_list_.clear();
   if (param_ != 0)
     delete[] param_;
   param_ = 0;
@@ -140,12 +147,21 @@ int GroupBulkRead::txPacket()
     return COMM_NOT_AVAILABLE;
 
   if (is_param_changed_ == true || param_ == 0)
+  {
     makeParam();
+    is_param_changed_ = false;
+  }
+
+  rx_index_ = 0;
 
   if (ph_->getProtocolVersion() == 1.0)
   {
     return ph_->bulkReadTx(port_, param_, id_list_.size() * 3);
   }
+  else if (is_fast_read_ == true)
+  {
+    return ph_->fastBulkReadTx(port_, param_, id_list_.size() * 5);
+  }
   else    // 2.0
   {
     return ph_->bulkReadTx(port_, param_, id_list_.size() * 5);
@@ -153,6 +169,16 @@ int GroupBulkRead::txPacket()
 }
 
 int GroupBulkRead::rxPacket()
+{
+  int result;
+
+  while ((result = pollRx()) == COMM_RX_WAITING)
+    port_->waitForBytes();
+
+  return result;
+}
+
+int GroupBulkRead::pollRx()
 {
   int cnt            = id_list_.size();
   int result          = COMM_RX_FAIL;
@@ -162,19 +188,49 @@ int GroupBulkRead::rxPacket()
   if (cnt == 0)
     return COMM_NOT_AVAILABLE;
 
-  for (int i = 0; i < cnt; i++)
+  if (is_fast_read_ == true && ph_->getProtocolVersion() == 2.0)
   {
-    uint8_t id = id_list_[i];
-
-    result = ph_->readRx(port_, id, length_list_[id], data_list_[id], error_list_[id]);
+    // the parameter goes straight into data_list_, the CRC16 of the last Dynamixel is the one of the packet
+    result = ph_->pollFastReadRx(port_, (uint16_t)(data_list_.size() - 2), &data_list_[0]);
     if (result != COMM_SUCCESS)
       return result;
-  }
 
-  if (result == COMM_SUCCESS)
+    for (int i = 0; i < cnt; i++)
+    {
+      if (data_list_[offset_list_[i] + 1] != id_list_[i])
+      {
+        // put the ids back for the next read
+        for (int j = 0; j < cnt; j++)
+          data_list_[offset_list_[j] + 1] = id_list_[j];
+        return COMM_RX_CORRUPT;
+      }
+    }
+
     last_result_ = true;
+    return result;
+  }
 
-  return result;
+  // the status packets are taken one by one from rx_index_, which the next call goes on from while they are not complete
+  while (rx_index_ < cnt)
+  {
+    uint8_t *slot = &data_list_[offset_list_[rx_index_]];
+    result = ph_->pollReadRx(port_, id_list_[rx_index_], length_list_[rx_index_], &slot[2], &slot[0]);
+    if (result == COMM_RX_WAITING)
+      return result;
+    if (result != COMM_SUCCESS)
+    {
+      rx_index_ = 0;
+      return result;
+    }
+
+    // give each ID its own estimated timeout after the first one
+    if (++rx_index_ < cnt && port_->getResponseTimeEstimator() != 0)
+      port_->setResponseTimeout(id_list_[rx_index_], INST_BULK_READ, length_list_[rx_index_] + ((ph_->getProtocolVersion() == 1.0) ? 6 : 11));
+  }
+
+  rx_index_    = 0;
+  last_result_ = true;
+  return COMM_SUCCESS;
 }
 
 int GroupBulkRead::txRxPacket()
@@ -190,14 +246,14 @@ int GroupBulkRead::txRxPacket()
 
 bool GroupBulkRead::isAvailable(uint8_t id, uint16_t address, uint16_t data_length)
 {
-  uint16_t start_addr;
+  int slot = slot_list_[id];
 
-  if (last_result_ == false || data_list_.find(id) == data_list_.end())
+  if (last_result_ == false || slot < 0)
     return false;
 
-  start_addr = address_list_[id];
+  uint16_t start_addr = address_list_[slot];
 
-  if (address < start_addr || start_addr + length_list_[id] - data_length < address)
+  if (address < start_addr || start_addr + length_list_[slot] - data_length < address)
     return false;
 
   return true;
@@ -208,19 +264,19 @@ uint32_t GroupBulkRead::getData(uint8_t id, uint16_t address, uint16_t data_leng
   if (isAvailable(id, address, data_length) == false)
     return 0;
 
-  uint16_t start_addr = address_list_[id];
+  int slot = slot_list_[id];
+  const uint8_t *data = &data_list_[offset_list_[slot] + 2 + (address - address_list_[slot])];
 
   switch(data_length)
   {
     case 1:
-      return data_list_[id][address - start_addr];
+      return data[0];
 
     case 2:
-      return DXL_MAKEWORD(data_list_[id][address - start_addr], data_list_[id][address - start_addr + 1]);
+      return DXL_MAKEWORD(data[0], data[1]);
 
     case 4:
-      return DXL_MAKEDWORD(DXL_MAKEWORD(data_list_[id][address - start_addr + 0], data_list_[id][address - start_addr + 1]),
-                           DXL_MAKEWORD(data_list_[id][address - start_addr + 2], data_list_[id][address - start_addr + 3]));
+      return DXL_MAKEDWORD(DXL_MAKEWORD(data[0], data[1]), DXL_MAKEWORD(data[2], data[3]));
 
     default:
       return 0;
@@ -229,8 +285,8 @@ uint32_t GroupBulkRead::getData(uint8_t id, uint16_t address, uint16_t data_leng
 
 bool GroupBulkRead::getError(uint8_t id, uint8_t* error)
 {
-  // TODO : check protocol version, last_result_, data_list
-  // if (last_result_ == false || error_list_.find(id) == error_list_.end())
+  if (last_result_ == false || slot_list_[id] < 0)
+    return false;
 
-  return error[0] = error_list_[id][0];
-}
\ No newline at end of file
+  return (error[0] = data_list_[offset_list_[slot_list_[id]]]) != 0;
+}
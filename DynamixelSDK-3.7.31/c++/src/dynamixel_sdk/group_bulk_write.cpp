@@ -117,14 +117,31 @@ bool GroupBulkWrite::changeParam(uint8_t id, uint16_t start_address, uint16_t da
   if (it == id_list_.end())    // NOT exist
     return false;
 
+  if (length_list_[id] != data_length)
+  {
+    delete[] data_list_[id];
+    data_list_[id]    = new uint8_t[data_length];
+    is_param_changed_ = true;
+  }
   address_list_[id]   = start_address;
   length_list_[id]    = data_length;
-  delete[] data_list_[id];
-  data_list_[id]      = new uint8_t[data_length];
   for (int c = 0; c < data_length; c++)
     data_list_[id][c] = data[c];
 
-  is_param_changed_   = true;
+  if (is_param_changed_ == true || param_ == 0)
+    return true;
+
+  // update the address and the data in the parameter made already
+  int idx = 0;
+  for (std::vector<uint8_t>::iterator i = id_list_.begin(); i != it; i++)
+    idx += 1 + 2 + 2 + length_list_[*i];
+
+  param_[idx + 1] = DXL_LOBYTE(start_address);
+  param_[idx + 2] = DXL_HIBYTE(start_address);
+  idx += 1 + 2 + 2;
+  for (int c = 0; c < data_length; c++)
+    param_[idx++] = data[c];
+
   return true;
 }
 void GroupBulkWrite::clearParam()
@@ -149,7 +166,10 @@ int GroupBulkWrite::txPacket()
     return COMM_NOT_AVAILABLE;
 
   if (is_param_changed_ == true || param_ == 0)
+  {
     makeParam();
+    is_param_changed_ = false;
+  }
 
   return ph_->bulkWriteTxOnly(port_, param_, param_length_);
 }
@@ -0,0 +1,250 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <string.h>
+
+#if defined(__linux__)
+#include "group_indirect_sync_read.h"
+#elif defined(__APPLE__)
+#include "group_indirect_sync_read.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "group_indirect_sync_read.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/group_indirect_sync_read.h"
+#endif
+
+using namespace dynamixel;
+
+GroupIndirectSyncRead::GroupIndirectSyncRead(PortHandler *port, PacketHandler *ph, uint16_t indirect_address, uint16_t indirect_data, uint16_t max_length)
+  : port_(port),
+    ph_(ph),
+    group_sync_read_(0),
+    is_param_changed_(false),
+    is_fast_read_(false),
+    indirect_address_(indirect_address),
+    indirect_data_(indirect_data),
+    max_length_(max_length)
+{
+  std::fill(data_length_, data_length_ + BROADCAST_ID, 0);
+}
+
+GroupIndirectSyncRead::~GroupIndirectSyncRead()
+{
+  clearParam();
+  if (group_sync_read_ != 0)
+    delete group_sync_read_;
+}
+
+void GroupIndirectSyncRead::makeGroupSyncRead()
+{
+  // all Dynamixels answer with the length of the longest list
+  uint16_t data_length = 0;
+  for (unsigned int i = 0; i < id_list_.size(); i++)
+    data_length = std::max(data_length, data_length_[id_list_[i]]);
+
+  if (group_sync_read_ != 0)
+    delete group_sync_read_;
+
+  group_sync_read_ = new GroupSyncRead(port_, ph_, indirect_data_, data_length);
+  group_sync_read_->setFastRead(is_fast_read_);
+  for (unsigned int i = 0; i < id_list_.size(); i++)
+    group_sync_read_->addParam(id_list_[i]);
+}
+
+const GroupIndirectSyncRead::Register *GroupIndirectSyncRead::findRegister(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (id >= BROADCAST_ID)
+    return 0;
+
+  std::vector<Register> &register_list = register_list_[id];
+  for (unsigned int i = 0; i < register_list.size(); i++)
+  {
+    if (register_list[i].address <= address && address + data_length <= register_list[i].address + register_list[i].length)
+      return &register_list[i];
+  }
+
+  return 0;
+}
+
+void GroupIndirectSyncRead::setFastRead(bool fast_read)
+{
+  is_fast_read_ = fast_read;
+  if (group_sync_read_ != 0)
+    group_sync_read_->setFastRead(fast_read);
+}
+
+bool GroupIndirectSyncRead::addParam(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (ph_->getProtocolVersion() == 1.0 || id >= BROADCAST_ID || data_length == 0)
+    return false;
+
+  if (data_length_[id] + data_length > max_length_)
+    return false;
+
+  std::vector<Register> &register_list = register_list_[id];
+  for (unsigned int i = 0; i < register_list.size(); i++)
+  {
+    if (register_list[i].address < address + data_length && address < register_list[i].address + register_list[i].length)
+      return false;
+  }
+
+  if (register_list.empty() == true)
+    id_list_.push_back(id);
+
+  Register item;
+  item.address  = address;
+  item.length   = data_length;
+  item.offset   = data_length_[id];
+  register_list.push_back(item);
+  data_length_[id] += data_length;
+
+  is_param_changed_ = true;
+  return true;
+}
+
+void GroupIndirectSyncRead::removeParam(uint8_t id)
+{
+  if (id >= BROADCAST_ID || register_list_[id].empty() == true)
+    return;
+
+  id_list_.erase(std::find(id_list_.begin(), id_list_.end(), id));
+  register_list_[id].clear();
+  data_length_[id] = 0;
+
+  is_param_changed_ = true;
+}
+
+void GroupIndirectSyncRead::clearParam()
+{
+  for (unsigned int i = 0; i < id_list_.size(); i++)
+  {
+    register_list_[id_list_[i]].clear();
+    data_length_[id_list_[i]] = 0;
+  }
+  id_list_.clear();
+
+  is_param_changed_ = true;
+}
+
+int GroupIndirectSyncRead::writeIndirectAddress(uint8_t id, uint8_t *error)
+{
+  if (ph_->getProtocolVersion() == 1.0 || id >= BROADCAST_ID || register_list_[id].empty() == true)
+    return COMM_NOT_AVAILABLE;
+
+  int       result    = COMM_TX_FAIL;
+  uint16_t  length    = data_length_[id] * 2;   // 2 bytes for each indirect address
+  uint8_t   dxl_error = 0;
+
+  std::vector<uint8_t> table(length);
+  std::vector<uint8_t> current(length);
+
+  // one indirect address for each byte of the registers
+  std::vector<Register> &register_list = register_list_[id];
+  for (unsigned int i = 0; i < register_list.size(); i++)
+  {
+    for (uint16_t b = 0; b < register_list[i].length; b++)
+    {
+      uint16_t address = register_list[i].address + b;
+      table[(register_list[i].offset + b) * 2 + 0] = DXL_LOBYTE(address);
+      table[(register_list[i].offset + b) * 2 + 1] = DXL_HIBYTE(address);
+    }
+  }
+
+  // the indirect addresses may be in EEPROM, so they are written only when they are different
+  result = ph_->readTxRx(port_, id, indirect_address_, length, &current[0], &dxl_error);
+  if (result == COMM_SUCCESS && dxl_error == 0 && memcmp(&table[0], &current[0], length) == 0)
+  {
+    if (error != 0)
+      *error = 0;
+    return result;
+  }
+
+  result = ph_->writeTxRx(port_, id, indirect_address_, length, &table[0], &dxl_error);
+  if (error != 0)
+    *error = dxl_error;
+
+  return result;
+}
+
+int GroupIndirectSyncRead::txPacket()
+{
+  if (ph_->getProtocolVersion() == 1.0 || id_list_.size() == 0)
+    return COMM_NOT_AVAILABLE;
+
+  if (is_param_changed_ == true || group_sync_read_ == 0)
+  {
+    makeGroupSyncRead();
+    is_param_changed_ = false;
+  }
+
+  return group_sync_read_->txPacket();
+}
+
+int GroupIndirectSyncRead::rxPacket()
+{
+  if (ph_->getProtocolVersion() == 1.0 || id_list_.size() == 0 || group_sync_read_ == 0)
+    return COMM_NOT_AVAILABLE;
+
+  return group_sync_read_->rxPacket();
+}
+
+int GroupIndirectSyncRead::pollRx()
+{
+  if (ph_->getProtocolVersion() == 1.0 || id_list_.size() == 0 || group_sync_read_ == 0)
+    return COMM_NOT_AVAILABLE;
+
+  return group_sync_read_->pollRx();
+}
+
+int GroupIndirectSyncRead::txRxPacket()
+{
+  int result = txPacket();
+  if (result != COMM_SUCCESS)
+    return result;
+
+  return rxPacket();
+}
+
+bool GroupIndirectSyncRead::isAvailable(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (group_sync_read_ == 0 || is_param_changed_ == true)
+    return false;
+
+  const Register *item = findRegister(id, address, data_length);
+  if (item == 0)
+    return false;
+
+  return group_sync_read_->isAvailable(id, indirect_data_ + item->offset + (address - item->address), data_length);
+}
+
+uint32_t GroupIndirectSyncRead::getData(uint8_t id, uint16_t address, uint16_t data_length)
+{
+  if (isAvailable(id, address, data_length) == false)
+    return 0;
+
+  const Register *item = findRegister(id, address, data_length);
+  return group_sync_read_->getData(id, indirect_data_ + item->offset + (address - item->address), data_length);
+}
+
+bool GroupIndirectSyncRead::getError(uint8_t id, uint8_t* error)
+{
+  if (group_sync_read_ == 0 || is_param_changed_ == true)
+    return false;
+
+  return group_sync_read_->getError(id, error);
+}
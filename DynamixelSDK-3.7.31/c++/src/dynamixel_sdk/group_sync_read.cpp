@@ -36,10 +36,13 @@ GroupSyncRead::GroupSyncRead(PortHandler *port, PacketHandler *ph, uint16_t star
     ph_(ph),
     last_result_(false),
     is_param_changed_(false),
+    is_fast_read_(false),
+    rx_index_(0),
     param_(0),
     start_address_(start_address),
     data_length_(data_length)
 {
+  std::fill(slot_list_, slot_list_ + 256, -1);
   clearParam();
 }
 
@@ -64,12 +67,13 @@ bool GroupSyncRead::addParam(uint8_t id)
   if (ph_->getProtocolVersion() == 1.0)
     return false;
 
-  if (std::find(id_list_.begin(), id_list_.end(), id) != id_list_.end())   // id already exist
+  if (slot_list_[id] >= 0)   // id already exist
     return false;
 
+  slot_list_[id] = (int16_t)id_list_.size();
   id_list_.push_back(id);
-  data_list_[id] = new uint8_t[data_length_];
-  error_list_[id] = new uint8_t[1];
+  data_list_.resize(id_list_.size() * (4 + data_length_));  // ERROR(1) + ID(1) + DATA(data_length) + CRC16(2)
+  data_list_[slot_list_[id] * (4 + data_length_) + 1] = id;
 
   is_param_changed_   = true;
   return true;
@@ -79,15 +83,15 @@ void GroupSyncRead::removeParam(uint8_t id)
   if (ph_->getProtocolVersion() == 1.0)
     return;
 
-  std::vector<uint8_t>::iterator it = std::find(id_list_.begin(), id_list_.end(), id);
-  if (it == id_list_.end())    // NOT exist
+  int slot = slot_list_[id];
+  if (slot < 0)    // NOT exist
     return;
 
-  id_list_.erase(it);
-  delete[] data_list_[id];
-  delete[] error_list_[id];
-  data_list_.erase(id);
-  error_list_.erase(id);
+  id_list_.erase(id_list_.begin() + slot);
+  data_list_.erase(data_list_.begin() + slot * (4 + data_length_), data_list_.begin() + (slot + 1) * (4 + data_length_));
+  slot_list_[id] = -1;
+  for (unsigned int i = slot; i < id_list_.size(); i++)
+    slot_list_[id_list_[i]] = (int16_t)i;
 
   is_param_changed_   = true;
 }
@@ -97,14 +101,10 @@ void GroupSyncRead::clearParam()
     return;
 
   for (unsigned int i = 0; i < id_list_.size(); i++)
-  {
-    delete[] data_list_[id_list_[i]];
-    delete[] error_list_[id_list_[i]];
-  }
+    slot_list_[id_list_[i]] = -1;
 
   id_list_.clear();
   data_list_.clear();
-  error_list_.clear();
   if (param_ != 0)
     delete[] param_;
   param_ = 0;
@@ -116,12 +116,30 @@ int GroupSyncRead::txPacket()
     return COMM_NOT_AVAILABLE;
 
   if (is_param_changed_ == true || param_ == 0)
+  {
     makeParam();
+    is_param_changed_ = false;
+  }
+
+  rx_index_ = 0;
+
+  if (is_fast_read_ == true)
+    return ph_->fastSyncReadTx(port_, start_address_, data_length_, param_, (uint16_t)id_list_.size() * 1);
 
   return ph_->syncReadTx(port_, start_address_, data_length_, param_, (uint16_t)id_list_.size() * 1);
 }
 
 int GroupSyncRead::rxPacket()
+{
+  int result;
+
+  while ((result = pollRx()) == COMM_RX_WAITING)
+    port_->waitForBytes();
+
+  return result;
+}
+
+int GroupSyncRead::pollRx()
 {
   last_result_ = false;
 
@@ -134,19 +152,49 @@ int GroupSyncRead::rxPacket()
   if (cnt == 0)
     return COMM_NOT_AVAILABLE;
 
-  for (int i = 0; i < cnt; i++)
+  if (is_fast_read_ == true)
   {
-    uint8_t id = id_list_[i];
-
-    result = ph_->readRx(port_, id, data_length_, data_list_[id], error_list_[id]);
+    // the parameter goes straight into data_list_, the CRC16 of the last Dynamixel is the one of the packet
+    result = ph_->pollFastReadRx(port_, (uint16_t)(data_list_.size() - 2), &data_list_[0]);
     if (result != COMM_SUCCESS)
       return result;
-  }
 
-  if (result == COMM_SUCCESS)
+    for (int i = 0; i < cnt; i++)
+    {
+      if (data_list_[i * (4 + data_length_) + 1] != id_list_[i])
+      {
+        // put the ids back for the next read
+        for (int j = 0; j < cnt; j++)
+          data_list_[j * (4 + data_length_) + 1] = id_list_[j];
+        return COMM_RX_CORRUPT;
+      }
+    }
+
     last_result_ = true;
+    return result;
+  }
 
-  return result;
+  // the status packets are taken one by one from rx_index_, which the next call goes on from while they are not complete
+  while (rx_index_ < cnt)
+  {
+    uint8_t *slot = &data_list_[rx_index_ * (4 + data_length_)];
+    result = ph_->pollReadRx(port_, id_list_[rx_index_], data_length_, &slot[2], &slot[0]);
+    if (result == COMM_RX_WAITING)
+      return result;
+    if (result != COMM_SUCCESS)
+    {
+      rx_index_ = 0;
+      return result;
+    }
+
+    // give each ID its own estimated timeout after the first one
+    if (++rx_index_ < cnt && port_->getResponseTimeEstimator() != 0)
+      port_->setResponseTimeout(id_list_[rx_index_], INST_SYNC_READ, 11 + data_length_);
+  }
+
+  rx_index_    = 0;
+  last_result_ = true;
+  return COMM_SUCCESS;
 }
 
 int GroupSyncRead::txRxPacket()
@@ -165,7 +213,7 @@ int GroupSyncRead::txRxPacket()
 
 bool GroupSyncRead::isAvailable(uint8_t id, uint16_t address, uint16_t data_length)
 {
-  if (ph_->getProtocolVersion() == 1.0 || last_result_ == false || data_list_.find(id) == data_list_.end())
+  if (ph_->getProtocolVersion() == 1.0 || last_result_ == false || slot_list_[id] < 0)
     return false;
 
   if (address < start_address_ || start_address_ + data_length_ - data_length < address)
@@ -179,17 +227,18 @@ uint32_t GroupSyncRead::getData(uint8_t id, uint16_t address, uint16_t data_leng
   if (isAvailable(id, address, data_length) == false)
     return 0;
 
+  const uint8_t *data = &data_list_[slot_list_[id] * (4 + data_length_) + 2 + (address - start_address_)];
+
   switch(data_length)
   {
     case 1:
-      return data_list_[id][address - start_address_];
+      return data[0];
 
     case 2:
-      return DXL_MAKEWORD(data_list_[id][address - start_address_], data_list_[id][address - start_address_ + 1]);
+      return DXL_MAKEWORD(data[0], data[1]);
 
     case 4:
-      return DXL_MAKEDWORD(DXL_MAKEWORD(data_list_[id][address - start_address_ + 0], data_list_[id][address - start_address_ + 1]),
-                 DXL_MAKEWORD(data_list_[id][address - start_address_ + 2], data_list_[id][address - start_address_ + 3]));
+      return DXL_MAKEDWORD(DXL_MAKEWORD(data[0], data[1]), DXL_MAKEWORD(data[2], data[3]));
 
     default:
       return 0;
@@ -198,8 +247,8 @@ uint32_t GroupSyncRead::getData(uint8_t id, uint16_t address, uint16_t data_leng
 
 bool GroupSyncRead::getError(uint8_t id, uint8_t* error)
 {
-  // TODO : check protocol version, last_result_, data_list
-  // if (ph_->getProtocolVersion() == 1.0 || last_result_ == false || error_list_.find(id) == error_list_.end())
+  if (ph_->getProtocolVersion() == 1.0 || last_result_ == false || slot_list_[id] < 0)
+    return false;
 
-  return error[0] = error_list_[id][0];
-}
\ No newline at end of file
+  return (error[0] = data_list_[slot_list_[id] * (4 + data_length_)]) != 0;
+}
@@ -36,6 +36,8 @@ GroupSyncWrite::GroupSyncWrite(PortHandler *port, PacketHandler *ph, uint16_t st
     ph_(ph),
     is_param_changed_(false),
     param_(0),
+    packet_(0),
+    packet_length_(0),
     start_address_(start_address),
     data_length_(data_length)
 {
@@ -63,6 +65,11 @@ void GroupSyncWrite::makeParam()
     for (int c = 0; c < data_length_; c++)
       param_[idx++] = (data_list_[id])[c];
   }
+
+  if (packet_ != 0)
+    delete[] packet_;
+  packet_ = new uint8_t[idx + 14];  // 14: the longest header and CRC16 of Sync Write
+  packet_length_ = ph_->makeSyncWritePacket(packet_, start_address_, data_length_, param_, idx);
 }
 
 bool GroupSyncWrite::addParam(uint8_t id, uint8_t *data)
@@ -98,20 +105,25 @@ bool GroupSyncWrite::changeParam(uint8_t id, uint8_t *data)
   if (it == id_list_.end())    // NOT exist
     return false;
 
-  delete[] data_list_[id];
-  data_list_[id]    = new uint8_t[data_length_];
   for (int c = 0; c < data_length_; c++)
     data_list_[id][c] = data[c];
 
-  is_param_changed_   = true;
+  if (is_param_changed_ == true || param_ == 0)
+    return true;
+
+  // update the data in the parameter and the packet made already
+  int idx = (it - id_list_.begin()) * (1 + data_length_) + 1;
+  for (int c = 0; c < data_length_; c++)
+    param_[idx + c] = data[c];
+
+  if (packet_length_ != 0 && ph_->updateSyncWritePacket(packet_, idx, data, data_length_) == false)
+    packet_length_ = 0;
+
   return true;
 }
 
 void GroupSyncWrite::clearParam()
 {
-  if (id_list_.size() == 0)
-    return;
-
   for (unsigned int i = 0; i < id_list_.size(); i++)
     delete[] data_list_[id_list_[i]];
 
@@ -120,6 +132,10 @@ void GroupSyncWrite::clearParam()
   if (param_ != 0)
     delete[] param_;
   param_ = 0;
+  if (packet_ != 0)
+    delete[] packet_;
+  packet_ = 0;
+  packet_length_ = 0;
 }
 
 int GroupSyncWrite::txPacket()
@@ -128,7 +144,18 @@ int GroupSyncWrite::txPacket()
     return COMM_NOT_AVAILABLE;
 
   if (is_param_changed_ == true || param_ == 0)
+  {
     makeParam();
+    is_param_changed_ = false;
+  }
+  else if (packet_length_ == 0)
+  {
+    // try again, the data needing byte stuffing might have been changed
+    packet_length_ = ph_->makeSyncWritePacket(packet_, start_address_, data_length_, param_, id_list_.size() * (1 + data_length_));
+  }
+
+  if (packet_length_ != 0)
+    return ph_->txSyncWritePacket(port_, packet_);
 
   return ph_->syncWriteTxOnly(port_, start_address_, data_length_, param_, id_list_.size() * (1 + data_length_));
 }
@@ -0,0 +1,234 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include "multi_bus_executor.h"
+#elif defined(__APPLE__)
+#include "multi_bus_executor.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include <windows.h>
+#include "multi_bus_executor.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/multi_bus_executor.h"
+#endif
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+
+#include <chrono>
+#include <stdio.h>
+
+using namespace dynamixel;
+
+static double getElapsedTime(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool pinThread(std::thread &thread, int cpu)
+{
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set) == 0;
+#elif defined(_WIN32) || defined(_WIN64)
+  return SetThreadAffinityMask((HANDLE)thread.native_handle(), (DWORD_PTR)1 << cpu) != 0;
+#else
+  // macOS has only affinity tags, which are hints to the scheduler
+  return false;
+#endif
+}
+
+MultiBusExecutor::MultiBusExecutor()
+  : generation_(0),
+    running_count_(0),
+    is_running_(false)
+{
+  clearStatistics();
+}
+
+MultiBusExecutor::~MultiBusExecutor()
+{
+  stop();
+  for (unsigned int i = 0; i < bus_list_.size(); i++)
+    delete bus_list_[i];
+}
+
+int MultiBusExecutor::addBus(CyclePlan *plan, int cpu)
+{
+  if (is_running_ == true)
+    return -1;
+
+  Bus *bus            = new Bus();
+  bus->plan           = plan;
+  bus->cpu            = cpu;
+  bus->result         = COMM_SUCCESS;
+  bus->cycle_time     = 0.0;
+  bus->max_cycle_time = 0.0;
+  bus->sum_cycle_time = 0.0;
+  bus_list_.push_back(bus);
+
+  return (int)bus_list_.size() - 1;
+}
+
+void MultiBusExecutor::clearStatistics()
+{
+  for (unsigned int i = 0; i < bus_list_.size(); i++)
+  {
+    bus_list_[i]->cycle_time     = 0.0;
+    bus_list_[i]->max_cycle_time = 0.0;
+    bus_list_[i]->sum_cycle_time = 0.0;
+  }
+
+  cycle_count_    = 0;
+  cycle_time_     = 0.0;
+  max_cycle_time_ = 0.0;
+  sum_cycle_time_ = 0.0;
+}
+
+bool MultiBusExecutor::start()
+{
+  if (bus_list_.size() == 0 || is_running_ == true)
+    return false;
+
+  {
+    // the threads begin at generation 0, so a count left by the last stop() must not start a cycle on them
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_     = 0;
+    running_count_  = 0;
+    is_running_     = true;
+  }
+
+  for (unsigned int i = 0; i < bus_list_.size(); i++)
+  {
+    Bus *bus = bus_list_[i];
+    bus->thread = std::thread(&MultiBusExecutor::process, this, bus);
+
+    if (bus->cpu >= 0 && pinThread(bus->thread, bus->cpu) == false)
+      printf("[MultiBusExecutor::start] The thread of bus %d could not be pinned to CPU %d!\n", i, bus->cpu);
+  }
+
+  return true;
+}
+
+void MultiBusExecutor::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_running_ == false)
+      return;
+    is_running_ = false;
+  }
+  start_condition_.notify_all();
+
+  for (unsigned int i = 0; i < bus_list_.size(); i++)
+    bus_list_[i]->thread.join();
+}
+
+void MultiBusExecutor::process(Bus *bus)
+{
+  unsigned long generation = 0;
+
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (generation_ == generation && is_running_ == true)
+        start_condition_.wait(lock);
+      if (is_running_ == false)
+      {
+        // a cycle started just before stop() is counted as not run, or MultiBusExecutor::txRxPacket() would wait forever
+        if (generation_ != generation)
+        {
+          bus->result = COMM_NOT_AVAILABLE;
+          if (--running_count_ == 0)
+            done_condition_.notify_one();
+        }
+        break;
+      }
+      generation = generation_;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bus->result     = bus->plan->txRxPacket();
+    bus->cycle_time = getElapsedTime(start);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--running_count_ == 0)
+        done_condition_.notify_one();
+    }
+  }
+}
+
+int MultiBusExecutor::txRxPacket()
+{
+  if (bus_list_.size() == 0)
+    return COMM_NOT_AVAILABLE;
+
+  if (is_running_ == false)
+    start();
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  // the barrier : all threads start the cycle together, and the last one to finish wakes the caller
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (is_running_ == false)   // stopped by another thread
+      return COMM_NOT_AVAILABLE;
+    running_count_ = (int)bus_list_.size();
+    generation_++;
+    start_condition_.notify_all();
+    while (running_count_ > 0)
+      done_condition_.wait(lock);
+  }
+
+  cycle_time_ = getElapsedTime(start);
+  cycle_count_++;
+  sum_cycle_time_ += cycle_time_;
+  if (cycle_time_ > max_cycle_time_)
+    max_cycle_time_ = cycle_time_;
+
+  int result = COMM_SUCCESS;
+  for (unsigned int i = 0; i < bus_list_.size(); i++)
+  {
+    Bus *bus = bus_list_[i];
+    bus->sum_cycle_time += bus->cycle_time;
+    if (bus->cycle_time > bus->max_cycle_time)
+      bus->max_cycle_time = bus->cycle_time;
+
+    if (result == COMM_SUCCESS && bus->result != COMM_SUCCESS)
+      result = bus->result;
+  }
+
+  return result;
+}
+
+double MultiBusExecutor::getEstimatedCycleTime()
+{
+  double cycle_time = 0.0;
+  for (unsigned int i = 0; i < bus_list_.size(); i++)
+  {
+    if (bus_list_[i]->plan->getCycleTime() > cycle_time)
+      cycle_time = bus_list_[i]->plan->getCycleTime();
+  }
+  return cycle_time;
+}
+
+#endif
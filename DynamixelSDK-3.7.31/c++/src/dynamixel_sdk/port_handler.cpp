@@ -16,19 +16,33 @@
 
 /* Author: zerom, Ryu Woon Jung (Leon) */
 
+#include <string.h>
+
 #if defined(__linux__)
+#include <unistd.h>
 #include "port_handler.h"
 #include "port_handler_linux.h"
+#include "packet_handler.h"
+#include "response_time_estimator.h"
 #elif defined(__APPLE__)
+#include <unistd.h>
 #include "port_handler.h"
 #include "port_handler_mac.h"
+#include "packet_handler.h"
+#include "response_time_estimator.h"
 #elif defined(_WIN32) || defined(_WIN64)
 #define WINDLLEXPORT
+#include <Windows.h>
+#include <intrin.h>
 #include "port_handler.h"
 #include "port_handler_windows.h"
+#include "packet_handler.h"
+#include "response_time_estimator.h"
 #elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
 #include "../../include/dynamixel_sdk/port_handler.h"
 #include "../../include/dynamixel_sdk/port_handler_arduino.h"
+#include "../../include/dynamixel_sdk/packet_handler.h"
+#include "../../include/dynamixel_sdk/response_time_estimator.h"
 #endif
 
 using namespace dynamixel;
@@ -45,3 +59,176 @@ PortHandler *PortHandler::getPortHandler(const char *port_name)
   return (PortHandler *)(new PortHandlerArduino(port_name));
 #endif
 }
+
+bool PortHandler::setUsing()
+{
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  if (is_using_ == true)
+    return false;
+  is_using_ = true;
+#elif defined(_MSC_VER)
+  if (_InterlockedExchange8((volatile char *)&is_using_, 1) != 0)
+    return false;
+#else
+  if (__atomic_exchange_n(&is_using_, true, __ATOMIC_ACQUIRE) == true)
+    return false;
+#endif
+
+  status_packet_count_ = 1;
+  return true;
+}
+
+void PortHandler::clearUsing()
+{
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+  is_using_ = false;
+#elif defined(_MSC_VER)
+  _InterlockedExchange8((volatile char *)&is_using_, 0);
+#else
+  __atomic_store_n(&is_using_, false, __ATOMIC_RELEASE);
+#endif
+}
+
+void PortHandler::endStatusPacket(int result)
+{
+  if (result == COMM_RX_WAITING)
+    return;
+
+  // between the status packets of a Sync Read or a Bulk Read, the port is not given to another thread
+  if (result == COMM_SUCCESS && status_packet_count_ > 1)
+  {
+    status_packet_count_--;
+    return;
+  }
+
+  status_packet_count_ = 0;
+  clearUsing();
+}
+
+void PortHandler::lockPort()
+{
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+  port_mutex_.lock();
+#endif
+}
+
+bool PortHandler::tryLockPort()
+{
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+  return port_mutex_.try_lock();
+#else
+  return true;
+#endif
+}
+
+void PortHandler::unlockPort()
+{
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+  port_mutex_.unlock();
+#endif
+}
+
+bool PortHandler::waitForBytes()
+{
+#if defined(__linux__) || defined(__APPLE__)
+  usleep(0);
+#elif defined(_WIN32) || defined(_WIN64)
+  Sleep(0);
+#endif
+  return true;
+}
+
+int PortHandler::fillRxBuffer()
+{
+  int read_length = 0;
+
+  while (true)
+  {
+    uint32_t free_length  = RX_BUFFER_SIZE - (rx_buffer_head_ - rx_buffer_tail_);
+    uint32_t head         = rx_buffer_head_ & (RX_BUFFER_SIZE - 1);
+    int      length       = (int)((free_length < RX_BUFFER_SIZE - head) ? free_length : RX_BUFFER_SIZE - head);
+    if (length == 0)
+      break;
+
+    int result = readPort(&rx_buffer_[head], length);
+    if (result <= 0)
+      break;
+    rx_buffer_head_ += result;
+    read_length     += result;
+
+    // read again only when the free space wrapped around the end of the buffer
+    if (result < length)
+      break;
+  }
+  return read_length;
+}
+
+int PortHandler::popRxBuffer(uint8_t *packet, int length)
+{
+  if (length > getRxBufferLength())
+    length = getRxBufferLength();
+
+  uint32_t tail   = rx_buffer_tail_ & (RX_BUFFER_SIZE - 1);
+  int      first  = (length < (int)(RX_BUFFER_SIZE - tail)) ? length : (int)(RX_BUFFER_SIZE - tail);
+
+  memcpy(packet, &rx_buffer_[tail], first);
+  memcpy(packet + first, &rx_buffer_[0], length - first);
+  rx_buffer_tail_ += length;
+
+  return length;
+}
+
+void PortHandler::skipRxBuffer(int length)
+{
+  if (length > getRxBufferLength())
+    length = getRxBufferLength();
+  rx_buffer_tail_ += length;
+}
+
+double PortHandler::getTxTimePerByte()
+{
+  int baudrate = getBaudRate();
+  return (baudrate > 0) ? (1000.0 / (double)baudrate) * 10.0 : 0.0;
+}
+
+void PortHandler::setResponseTimeout(uint8_t id, uint8_t instruction, uint16_t packet_length)
+{
+  double timeout = -1.0;
+
+  if (response_time_estimator_ != 0)
+    timeout = response_time_estimator_->getTimeout(id, instruction);
+  response_id_          = id;
+  response_instruction_ = instruction;
+
+  if (timeout > 0.0)
+    setPacketTimeout(timeout + getTxTimePerByte() * packet_length);
+  else
+    setPacketTimeout(packet_length);
+
+  is_response_pending_  = true;
+}
+
+void PortHandler::addResponseTime(uint8_t id, uint16_t packet_length)
+{
+  is_response_pending_ = false;
+  if (response_time_estimator_ == 0)
+    return;
+
+  double elapsed_time = getPacketElapsedTime();
+  if (elapsed_time < 0.0)
+    return;
+
+  // the estimator keeps the time until the status packet begins, the transfer is added back by PortHandler::setResponseTimeout()
+  elapsed_time -= getTxTimePerByte() * packet_length;
+  response_time_estimator_->addSample(id, response_instruction_, (elapsed_time > 0.0) ? elapsed_time : 0.0);
+}
+
+void PortHandler::addResponseTimeout()
+{
+  if (is_response_pending_ == false)
+    return;
+  is_response_pending_ = false;
+
+  if (response_time_estimator_ != 0)
+    response_time_estimator_->addTimeout(response_id_, response_instruction_);
+}
@@ -103,6 +103,7 @@ void PortHandlerArduino::clearPort()
       temp = p_dxl_serial->read();
   }
 #endif
+  clearRxBuffer();
 }
 
 void PortHandlerArduino::setPortName(const char *port_name)
@@ -210,6 +211,11 @@ bool PortHandlerArduino::isPacketTimeout()
   return false;
 }
 
+double PortHandlerArduino::getPacketElapsedTime()
+{
+  return getTimeSinceStart();
+}
+
 double PortHandlerArduino::getCurrentTime()
 {
   return (double)millis();
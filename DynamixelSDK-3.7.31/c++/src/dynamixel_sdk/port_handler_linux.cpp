@@ -18,9 +18,13 @@
 
 #if defined(__linux__)
 
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <string.h>
+#include <poll.h>
 #include <unistd.h>
 #include <termios.h>
 #include <time.h>
@@ -31,12 +35,13 @@
 #include "port_handler_linux.h"
 
 #define LATENCY_TIMER  16  // msec (USB latency timer)
-                           // You should adjust the latency timer value. From the version Ubuntu 16.04.2, the default latency timer of the usb serial is '16 msec'.
+                           // Default latency timer, used when the adapter doesn't report one. From the version Ubuntu 16.04.2, the default latency timer of the usb serial is '16 msec'.
                            // When you are going to use sync / bulk read, the latency timer should be loosen.
                            // the lower latency timer value, the faster communication speed.
 
                            // Note:
-                           // You can check its value by:
+                           // openPort() reads the latency timer of the adapter from sysfs and tries to lower it to 1 msec by itself.
+                           // Writing it requires permission, so without root the value is only read. You can check its value by:
                            // $ cat /sys/bus/usb-serial/devices/ttyUSB0/latency_timer
                            //
                            // If you think that the communication is too slow, type following after plugging the usb in to change the latency timer
@@ -60,9 +65,11 @@ using namespace dynamixel;
 PortHandlerLinux::PortHandlerLinux(const char *port_name)
   : socket_fd_(-1),
     baudrate_(DEFAULT_BAUDRATE_),
-    packet_start_time_(0.0),
-    packet_timeout_(0.0),
-    tx_time_per_byte(0.0)
+    clock_(getMonotonicTime),
+    packet_start_time_(0),
+    packet_deadline_(0),
+    tx_time_per_byte(0.0),
+    latency_timer_(LATENCY_TIMER)
 {
   is_using_ = false;
   setPortName(port_name);
@@ -70,7 +77,12 @@ PortHandlerLinux::PortHandlerLinux(const char *port_name)
 
 bool PortHandlerLinux::openPort()
 {
-  return setBaudRate(baudrate_);
+  if (setBaudRate(baudrate_) == false)
+    return false;
+
+  // the settings stay with the device, so they are not made again on every PortHandlerLinux::setBaudRate()
+  setupLowLatency();
+  return true;
 }
 
 void PortHandlerLinux::closePort()
@@ -83,6 +95,7 @@ void PortHandlerLinux::closePort()
 void PortHandlerLinux::clearPort()
 {
   tcflush(socket_fd_, TCIFLUSH);
+  clearRxBuffer();
 }
 
 void PortHandlerLinux::setPortName(const char *port_name)
@@ -120,6 +133,16 @@ int PortHandlerLinux::getBaudRate()
   return baudrate_;
 }
 
+int PortHandlerLinux::getLatencyTimer()
+{
+  return latency_timer_;
+}
+
+int PortHandlerLinux::getSocketFd()
+{
+  return socket_fd_;
+}
+
 int PortHandlerLinux::getBytesAvailable()
 {
   int bytes_available;
@@ -139,42 +162,78 @@ int PortHandlerLinux::writePort(uint8_t *packet, int length)
 
 void PortHandlerLinux::setPacketTimeout(uint16_t packet_length)
 {
-  packet_start_time_  = getCurrentTime();
-  packet_timeout_     = (tx_time_per_byte * (double)packet_length) + (LATENCY_TIMER * 2.0) + 2.0;
+  setPacketTimeout((tx_time_per_byte * (double)packet_length) + (latency_timer_ * 2.0) + 2.0);
 }
 
 void PortHandlerLinux::setPacketTimeout(double msec)
 {
   packet_start_time_  = getCurrentTime();
-  packet_timeout_     = msec;
+  packet_deadline_    = packet_start_time_ + (int64_t)(msec * 1000000.0);
 }
 
 bool PortHandlerLinux::isPacketTimeout()
 {
-  if(getTimeSinceStart() > packet_timeout_)
+  return getCurrentTime() > packet_deadline_;
+}
+
+double PortHandlerLinux::getPacketElapsedTime()
+{
+  return (double)(getCurrentTime() - packet_start_time_) / 1000000.0;
+}
+
+double PortHandlerLinux::getPacketRemainingTime()
+{
+  return (double)(packet_deadline_ - getCurrentTime()) / 1000000.0;
+}
+
+bool PortHandlerLinux::waitForBytes()
+{
+  while (true)
   {
-    packet_timeout_ = 0;
-    return true;
+    int64_t remaining_time = packet_deadline_ - getCurrentTime();
+    if (remaining_time <= 0)
+      return false;
+
+    struct pollfd pfd;
+    pfd.fd      = socket_fd_;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    // a replaced clock runs on virtual time, so only check the port without blocking
+    struct timespec timeout = { 0, 0 };
+    if (clock_ == getMonotonicTime)
+    {
+      timeout.tv_sec  = (time_t)(remaining_time / 1000000000);
+      timeout.tv_nsec = (long)(remaining_time % 1000000000);
+    }
+
+    int result = ppoll(&pfd, 1, &timeout, NULL);
+    if (result < 0 && errno == EINTR)   // interrupted by a signal, wait again for the time left
+      continue;
+
+    // an unplugged adapter hangs up the port: the bytes already come are still read, but no more are waited for
+    if (result < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0)
+      setPortError();
+
+    return result > 0 && (pfd.revents & POLLIN) != 0;
   }
-  return false;
 }
 
-double PortHandlerLinux::getCurrentTime()
+void PortHandlerLinux::setClock(ClockFunction clock)
 {
-	struct timespec tv;
-	clock_gettime(CLOCK_REALTIME, &tv);
-	return ((double)tv.tv_sec * 1000.0 + (double)tv.tv_nsec * 0.001 * 0.001);
+  clock_ = (clock != 0) ? clock : getMonotonicTime;
 }
 
-double PortHandlerLinux::getTimeSinceStart()
+int64_t PortHandlerLinux::getMonotonicTime()
 {
-  double time;
-
-  time = getCurrentTime() - packet_start_time_;
-  if(time < 0.0)
-    packet_start_time_ = getCurrentTime();
+  struct timespec tv;
+  clock_gettime(CLOCK_MONOTONIC, &tv);
+  return (int64_t)tv.tv_sec * 1000000000 + (int64_t)tv.tv_nsec;
+}
 
-  return time;
+int64_t PortHandlerLinux::getCurrentTime()
+{
+  return clock_();
 }
 
 bool PortHandlerLinux::setupPort(int cflag_baud)
@@ -205,6 +264,65 @@ bool PortHandlerLinux::setupPort(int cflag_baud)
   return true;
 }
 
+static int readLatencyTimer(const char *sysfs_path)
+{
+  int latency_timer = -1;
+
+  FILE *fp = fopen(sysfs_path, "r");
+  if (fp == NULL)
+    return -1;
+  if (fscanf(fp, "%d", &latency_timer) != 1)
+    latency_timer = -1;
+  fclose(fp);
+
+  return latency_timer;
+}
+
+void PortHandlerLinux::setupLowLatency()
+{
+  latency_timer_ = LATENCY_TIMER;
+
+  // ask the serial driver to deliver received bytes without delay
+  struct serial_struct ss;
+  if (ioctl(socket_fd_, TIOCGSERIAL, &ss) == 0 && (ss.flags & ASYNC_LOW_LATENCY) == 0)
+  {
+    ss.flags |= ASYNC_LOW_LATENCY;
+    ioctl(socket_fd_, TIOCSSERIAL, &ss);
+  }
+
+  // find the latency timer of the usb-serial (FTDI) adapter, following symlinks such as /dev/serial/by-id/*
+  char device_path[PATH_MAX];
+  if (realpath(port_name_, device_path) == NULL)
+    return;
+
+  const char *device_name = strrchr(device_path, '/');
+  device_name = (device_name == NULL) ? device_path : device_name + 1;
+
+  char sysfs_path[PATH_MAX + 64];
+  snprintf(sysfs_path, sizeof(sysfs_path), "/sys/bus/usb-serial/devices/%s/latency_timer", device_name);
+
+  int latency_timer = readLatencyTimer(sysfs_path);
+  if (latency_timer < 0)    // the adapter has no latency timer
+    return;
+
+  if (latency_timer > 1)
+  {
+    FILE *fp = fopen(sysfs_path, "w");
+    if (fp != NULL)
+    {
+      fprintf(fp, "1");
+      fclose(fp);
+      latency_timer = readLatencyTimer(sysfs_path);
+    }
+
+    if (latency_timer > 1)
+      printf("[PortHandlerLinux::SetupLowLatency] Latency timer is %d msec. Write 1 to %s for faster communication.\n", latency_timer, sysfs_path);
+  }
+
+  if (latency_timer >= 0)
+    latency_timer_ = latency_timer;
+}
+
 bool PortHandlerLinux::setCustomBaudrate(int speed)
 {
   // try to set a custom divisor
@@ -71,6 +71,7 @@ void PortHandlerMac::closePort()
 void PortHandlerMac::clearPort()
 {
   tcflush(socket_fd_, TCIFLUSH);
+  clearRxBuffer();
 }
 
 void PortHandlerMac::setPortName(const char *port_name)
@@ -147,6 +148,11 @@ bool PortHandlerMac::isPacketTimeout()
   return false;
 }
 
+double PortHandlerMac::getPacketElapsedTime()
+{
+  return getTimeSinceStart();
+}
+
 double PortHandlerMac::getCurrentTime()
 {
   struct timespec tv;
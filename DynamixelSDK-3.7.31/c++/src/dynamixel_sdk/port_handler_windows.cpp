@@ -68,6 +68,7 @@ void PortHandlerWindows::closePort()
 void PortHandlerWindows::clearPort()
 {
   PurgeComm(serial_handle_, PURGE_RXABORT | PURGE_RXCLEAR);
+  clearRxBuffer();
 }
 
 void PortHandlerWindows::setPortName(const char *port_name)
@@ -144,6 +145,11 @@ bool PortHandlerWindows::isPacketTimeout()
   return false;
 }
 
+double PortHandlerWindows::getPacketElapsedTime()
+{
+  return getTimeSinceStart();
+}
+
 double PortHandlerWindows::getCurrentTime()
 {
   QueryPerformanceCounter(&counter_);
@@ -125,14 +125,13 @@ int Protocol1PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
   uint8_t total_packet_length    = txpacket[PKT_LENGTH] + 4; // 4: HEADER0 HEADER1 ID LENGTH
   uint8_t written_packet_length  = 0;
 
-  if (port->is_using_)
+  if (port->setUsing() == false)
     return COMM_PORT_BUSY;
-  port->is_using_ = true;
 
   // check max packet length
   if (total_packet_length > TXPACKET_MAX_LEN)
   {
-    port->is_using_ = false;
+    port->clearUsing();
     return COMM_TX_ERROR;
   }
 
@@ -150,100 +149,90 @@ int Protocol1PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
   written_packet_length = port->writePort(txpacket, total_packet_length);
   if (total_packet_length != written_packet_length)
   {
-    port->is_using_ = false;
+    port->clearUsing();
     return COMM_TX_FAIL;
   }
 
   return COMM_SUCCESS;
 }
 
-int Protocol1PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
+int Protocol1PacketHandler::pollStatusPacket(PortHandler *port, uint8_t *rxpacket)
 {
-  int     result         = COMM_TX_FAIL;
+  int     result         = COMM_RX_WAITING;
 
-  uint8_t checksum       = 0;
-  uint8_t rx_length      = 0;
-  uint8_t wait_length    = 6;    // minimum length (HEADER0 HEADER1 ID LENGTH ERROR CHKSUM)
+  uint8_t  checksum      = 0;
+  uint16_t rx_length     = 0;
+  uint16_t wait_length   = 6;    // minimum length (HEADER0 HEADER1 ID LENGTH ERROR CHKSUM)
 
   while(true)
   {
-    rx_length += port->readPort(&rxpacket[rx_length], wait_length - rx_length);
+    // the bytes stay in the receive buffer of the port until a whole packet is found
+    port->fillRxBuffer();
+    rx_length = port->getRxBufferLength();
     if (rx_length >= wait_length)
     {
-      uint8_t idx = 0;
+      uint16_t idx = 0;
 
       // find packet header
       for (idx = 0; idx < (rx_length - 1); idx++)
       {
-        if (rxpacket[idx] == 0xFF && rxpacket[idx+1] == 0xFF)
+        if (port->peekRxBuffer(idx) == 0xFF && port->peekRxBuffer(idx+1) == 0xFF)
           break;
       }
 
       if (idx == 0)   // found at the beginning of the packet
       {
-        if (rxpacket[PKT_ID] > 0xFD ||                  // unavailable ID
-            rxpacket[PKT_LENGTH] > RXPACKET_MAX_LEN ||  // unavailable Length
-            rxpacket[PKT_ERROR] > 0x7F)                 // unavailable Error
+        if (port->peekRxBuffer(PKT_ID) > 0xFD ||                  // unavailable ID
+            port->peekRxBuffer(PKT_LENGTH) > RXPACKET_MAX_LEN ||  // unavailable Length
+            port->peekRxBuffer(PKT_ERROR) > 0x7F)                 // unavailable Error
         {
             // remove the first byte in the packet
-            for (uint16_t s = 0; s < rx_length - 1; s++)
-              rxpacket[s] = rxpacket[1 + s];
-            //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-            rx_length -= 1;
+            port->skipRxBuffer(1);
             continue;
         }
 
         // re-calculate the exact length of the rx packet
-        if (wait_length != rxpacket[PKT_LENGTH] + PKT_LENGTH + 1)
+        if (wait_length != port->peekRxBuffer(PKT_LENGTH) + PKT_LENGTH + 1)
         {
-          wait_length = rxpacket[PKT_LENGTH] + PKT_LENGTH + 1;
+          wait_length = port->peekRxBuffer(PKT_LENGTH) + PKT_LENGTH + 1;
           continue;
         }
 
-        if (rx_length < wait_length)
+        if (rx_length >= wait_length)
         {
-          // check timeout
-          if (port->isPacketTimeout() == true)
+          // take the packet out of the buffer, the following bytes are left for the next packet
+          port->popRxBuffer(rxpacket, wait_length);
+
+          // calculate checksum
+          for (uint16_t i = 2; i < wait_length - 1; i++)   // except header, checksum
+            checksum += rxpacket[i];
+          checksum = ~checksum;
+
+          // verify checksum
+          if (rxpacket[wait_length - 1] == checksum)
           {
-            if (rx_length == 0)
-            {
-              result = COMM_RX_TIMEOUT;
-            }
-            else
-            {
-              result = COMM_RX_CORRUPT;
-            }
-            break;
+            result = COMM_SUCCESS;
           }
           else
           {
-            continue;
+            result = COMM_RX_CORRUPT;
           }
+          break;
         }
 
-        // calculate checksum
-        for (uint16_t i = 2; i < wait_length - 1; i++)   // except header, checksum
-          checksum += rxpacket[i];
-        checksum = ~checksum;
-
-        // verify checksum
-        if (rxpacket[wait_length - 1] == checksum)
-        {
-          result = COMM_SUCCESS;
-        }
-        else
+        // check timeout
+        if (port->isPacketTimeout() == true)
         {
+          port->addResponseTimeout();
           result = COMM_RX_CORRUPT;
+          break;
         }
-        break;
       }
       else
       {
         // remove unnecessary packets
-        for (uint16_t s = 0; s < rx_length - idx; s++)
-          rxpacket[s] = rxpacket[idx + s];
-        //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-        rx_length -= idx;
+        port->skipRxBuffer(idx);
+        continue;
       }
     }
     else
@@ -251,6 +240,7 @@ int Protocol1PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
       // check timeout
       if (port->isPacketTimeout() == true)
       {
+        port->addResponseTimeout();
         if (rx_length == 0)
         {
           result = COMM_RX_TIMEOUT;
@@ -262,8 +252,36 @@ int Protocol1PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
         break;
       }
     }
+    // no more bytes come from a port which has failed
+    if (port->isPortError() == true)
+    {
+      result = COMM_RX_FAIL;
+      break;
+    }
+
+    // the rest of the packet is taken by the next call
+    break;
   }
-  port->is_using_ = false;
+
+  return result;
+}
+
+int Protocol1PacketHandler::pollRxPacket(PortHandler *port, uint8_t *rxpacket)
+{
+  int result = pollStatusPacket(port, rxpacket);
+
+  // the port stays in use until the packet is complete or timed out
+  port->endStatusPacket(result);
+
+  return result;
+}
+
+int Protocol1PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
+{
+  int result;
+
+  while ((result = pollRxPacket(port, rxpacket)) == COMM_RX_WAITING)
+    port->waitForBytes();
 
   return result;
 }
@@ -286,30 +304,33 @@ int Protocol1PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
   // (Instruction == action) == no need to wait for status packet
   if (txpacket[PKT_ID] == BROADCAST_ID || txpacket[PKT_INSTRUCTION] == INST_ACTION)
   {
-    port->is_using_ = false;
+    port->clearUsing();
     return result;
   }
 
   // set packet timeout
   if (txpacket[PKT_INSTRUCTION] == INST_READ)
   {
-    port->setPacketTimeout((uint16_t)(txpacket[PKT_PARAMETER0+1] + 6));
+    port->setResponseTimeout(txpacket[PKT_ID], txpacket[PKT_INSTRUCTION], (uint16_t)(txpacket[PKT_PARAMETER0+1] + 6));
   }
   else
   {
-    port->setPacketTimeout((uint16_t)6); // HEADER0 HEADER1 ID LENGTH ERROR CHECKSUM
+    port->setResponseTimeout(txpacket[PKT_ID], txpacket[PKT_INSTRUCTION], (uint16_t)6); // HEADER0 HEADER1 ID LENGTH ERROR CHECKSUM
   }
 
-  // rx packet
+  // rx packet, the port is kept over the packets of the other IDs
   do {
-    result = rxPacket(port, rxpacket);
+    while ((result = pollStatusPacket(port, rxpacket)) == COMM_RX_WAITING)
+      port->waitForBytes();
   } while (result == COMM_SUCCESS && txpacket[PKT_ID] != rxpacket[PKT_ID]);
 
   if (result == COMM_SUCCESS && txpacket[PKT_ID] == rxpacket[PKT_ID])
   {
+    port->addResponseTime(rxpacket[PKT_ID], (uint16_t)(rxpacket[PKT_LENGTH] + 4));
     if (error != 0)
       *error = (uint8_t)rxpacket[PKT_ERROR];
   }
+  port->endStatusPacket(result);
 
   return result;
 }
@@ -344,11 +365,38 @@ int Protocol1PacketHandler::ping(PortHandler *port, uint8_t id, uint16_t *model_
   return result;
 }
 
+int Protocol1PacketHandler::pingTx(PortHandler *port, uint8_t id)
+{
+  int result                 = COMM_TX_FAIL;
+
+  uint8_t txpacket[6]         = {0};
+
+  if (id >= BROADCAST_ID)
+    return COMM_NOT_AVAILABLE;
+
+  txpacket[PKT_ID]            = id;
+  txpacket[PKT_LENGTH]        = 2;
+  txpacket[PKT_INSTRUCTION]   = INST_PING;
+
+  result = txPacket(port, txpacket);
+
+  // set packet timeout
+  if (result == COMM_SUCCESS)
+    port->setResponseTimeout(id, INST_PING, (uint16_t)6);
+
+  return result;
+}
+
 int Protocol1PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t> &id_list)
 {
   return COMM_NOT_AVAILABLE;
 }
 
+int Protocol1PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t> &id_list, double idle_time, int expected_count)
+{
+  return COMM_NOT_AVAILABLE;
+}
+
 int Protocol1PacketHandler::action(PortHandler *port, uint8_t id)
 {
   uint8_t txpacket[6]         = {0};
@@ -401,26 +449,23 @@ int Protocol1PacketHandler::readTx(PortHandler *port, uint8_t id, uint16_t addre
 
   // set packet timeout
   if (result == COMM_SUCCESS)
-    port->setPacketTimeout((uint16_t)(length+6));
+    port->setResponseTimeout(id, INST_READ, (uint16_t)(length+6));
 
   return result;
 }
 
-int Protocol1PacketHandler::readRx(PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error)
+int Protocol1PacketHandler::pollReadRx(PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error)
 {
   int result                  = COMM_TX_FAIL;
-  uint8_t *rxpacket           = (uint8_t *)malloc(RXPACKET_MAX_LEN); //(length+6);
-  //uint8_t *rxpacket         = new uint8_t[length+6];
-
-  if (rxpacket == NULL)
-    return result;
+  uint8_t *rxpacket           = port->getRxPacketBuffer();
 
   do {
-    result = rxPacket(port, rxpacket);
+    result = pollStatusPacket(port, rxpacket);
   } while (result == COMM_SUCCESS && rxpacket[PKT_ID] != id);
 
   if (result == COMM_SUCCESS && rxpacket[PKT_ID] == id)
   {
+    port->addResponseTime(id, (uint16_t)(length + 6));
     if (error != 0)
     {
       *error = (uint8_t)rxpacket[PKT_ERROR];
@@ -432,49 +477,31 @@ int Protocol1PacketHandler::readRx(PortHandler *port, uint8_t id, uint16_t lengt
     //memcpy(data, &rxpacket[PKT_PARAMETER0], length);
   }
 
-  free(rxpacket);
-  //delete[] rxpacket;
+  // the buffer of the port is given to another thread only after the data is taken
+  port->endStatusPacket(result);
+
   return result;
 }
 
-int Protocol1PacketHandler::readTxRx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error)
+int Protocol1PacketHandler::readRx(PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error)
 {
-  int result = COMM_TX_FAIL;
+  int result;
 
-  uint8_t txpacket[8]         = {0};
-  uint8_t *rxpacket           = (uint8_t *)malloc(RXPACKET_MAX_LEN);//(length+6);
-
-  if (rxpacket == NULL)
-    return result;
+  while ((result = pollReadRx(port, id, length, data, error)) == COMM_RX_WAITING)
+    port->waitForBytes();
 
-  if (id >= BROADCAST_ID)
-  {
-    free(rxpacket);
-    return COMM_NOT_AVAILABLE;
-  }
+  return result;
+}
 
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH]        = 4;
-  txpacket[PKT_INSTRUCTION]   = INST_READ;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)address;
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)length;
+int Protocol1PacketHandler::readTxRx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error)
+{
+  int result = COMM_TX_FAIL;
 
-  result = txRxPacket(port, txpacket, rxpacket, error);
+  // the data is taken out of the buffer of the port by readRx() before the port is released
+  result = readTx(port, id, address, length);
   if (result == COMM_SUCCESS)
-  {
-    if (error != 0)
-    {
-      *error = (uint8_t)rxpacket[PKT_ERROR];
-    }
-    for (uint16_t s = 0; s < length; s++)
-    {
-      data[s] = rxpacket[PKT_PARAMETER0 + s];
-    }
-    //memcpy(data, &rxpacket[PKT_PARAMETER0], length);
-  }
+    result = readRx(port, id, length, data, error);
 
-  free(rxpacket);
-  //delete[] rxpacket;
   return result;
 }
 
@@ -545,11 +572,38 @@ int Protocol1PacketHandler::writeTxOnly(PortHandler *port, uint8_t id, uint16_t
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length+7);
-  //uint8_t *txpacket           = new uint8_t[length+7];
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
 
-  if (txpacket == NULL)
-    return result;
+  if (length+7 > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
+
+  txpacket[PKT_ID]            = id;
+  txpacket[PKT_LENGTH]        = length+3;
+  txpacket[PKT_INSTRUCTION]   = INST_WRITE;
+  txpacket[PKT_PARAMETER0]    = (uint8_t)address;
+
+  for (uint16_t s = 0; s < length; s++)
+    txpacket[PKT_PARAMETER0+1+s] = data[s];
+  //memcpy(&txpacket[PKT_PARAMETER0+1], data, length);
+
+  result = txPacket(port, txpacket);
+  if (result == COMM_SUCCESS)   // on failure txPacket() has released the port, or another thread has it
+    port->clearUsing();
+
+  return result;
+}
+
+int Protocol1PacketHandler::writeTx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data)
+{
+  int result                 = COMM_TX_FAIL;
+
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
+
+  if (id >= BROADCAST_ID)
+    return COMM_NOT_AVAILABLE;
+
+  if (length+7 > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
 
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH]        = length+3;
@@ -561,10 +615,11 @@ int Protocol1PacketHandler::writeTxOnly(PortHandler *port, uint8_t id, uint16_t
   //memcpy(&txpacket[PKT_PARAMETER0+1], data, length);
 
   result = txPacket(port, txpacket);
-  port->is_using_ = false;
 
-  free(txpacket);
-  //delete[] txpacket;
+  // set packet timeout
+  if (result == COMM_SUCCESS)
+    port->setResponseTimeout(id, INST_WRITE, (uint16_t)6); // HEADER0 HEADER1 ID LENGTH ERROR CHECKSUM
+
   return result;
 }
 
@@ -572,12 +627,11 @@ int Protocol1PacketHandler::writeTxRx(PortHandler *port, uint8_t id, uint16_t ad
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length+7); //#6->7
-  //uint8_t *txpacket           = new uint8_t[length+7];
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   uint8_t rxpacket[6]         = {0};
 
-  if (txpacket == NULL)
-    return result;
+  if (length+7 > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
 
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH]        = length+3;
@@ -590,8 +644,6 @@ int Protocol1PacketHandler::writeTxRx(PortHandler *port, uint8_t id, uint16_t ad
 
   result = txRxPacket(port, txpacket, rxpacket, error);
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -632,11 +684,10 @@ int Protocol1PacketHandler::regWriteTxOnly(PortHandler *port, uint8_t id, uint16
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length+6);
-  //uint8_t *txpacket           = new uint8_t[length+6];
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
 
-  if (txpacket == NULL)
-    return result;
+  if (length+6 > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
 
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH]        = length+3;
@@ -648,10 +699,9 @@ int Protocol1PacketHandler::regWriteTxOnly(PortHandler *port, uint8_t id, uint16
   //memcpy(&txpacket[PKT_PARAMETER0+1], data, length);
 
   result = txPacket(port, txpacket);
-  port->is_using_ = false;
+  if (result == COMM_SUCCESS)   // on failure txPacket() has released the port, or another thread has it
+    port->clearUsing();
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -659,12 +709,11 @@ int Protocol1PacketHandler::regWriteTxRx(PortHandler *port, uint8_t id, uint16_t
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length+6);
-  //uint8_t *txpacket           = new uint8_t[length+6];
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   uint8_t rxpacket[6]         = {0};
 
-  if (txpacket == NULL)
-    return result;
+  if (length+6 > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
 
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH]        = length+3;
@@ -677,8 +726,6 @@ int Protocol1PacketHandler::regWriteTxRx(PortHandler *port, uint8_t id, uint16_t
 
   result = txRxPacket(port, txpacket, rxpacket, error);
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -687,16 +734,30 @@ int Protocol1PacketHandler::syncReadTx(PortHandler *port, uint16_t start_address
   return COMM_NOT_AVAILABLE;
 }
 
+int Protocol1PacketHandler::fastSyncReadTx(PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  return COMM_NOT_AVAILABLE;
+}
+
+int Protocol1PacketHandler::fastReadRx(PortHandler *port, uint16_t length, uint8_t *param)
+{
+  return COMM_NOT_AVAILABLE;
+}
+
+int Protocol1PacketHandler::pollFastReadRx(PortHandler *port, uint16_t length, uint8_t *param)
+{
+  return COMM_NOT_AVAILABLE;
+}
+
 int Protocol1PacketHandler::syncWriteTxOnly(PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length+8);
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   // 8: HEADER0 HEADER1 ID LEN INST START_ADDR DATA_LEN ... CHKSUM
-  //uint8_t *txpacket           = new uint8_t[param_length + 8];
 
-  if (txpacket == NULL)
-    return result;
+  if (param_length+8 > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
 
   txpacket[PKT_ID]            = BROADCAST_ID;
   txpacket[PKT_LENGTH]        = param_length + 4; // 4: INST START_ADDR DATA_LEN ... CHKSUM
@@ -710,21 +771,80 @@ int Protocol1PacketHandler::syncWriteTxOnly(PortHandler *port, uint16_t start_ad
 
   result = txRxPacket(port, txpacket, 0, 0);
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
+uint16_t Protocol1PacketHandler::makeSyncWritePacket(uint8_t *txpacket, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  uint8_t checksum              = 0;
+  uint16_t total_packet_length  = param_length + 8;
+  // 8: HEADER0 HEADER1 ID LEN INST START_ADDR DATA_LEN ... CHKSUM
+
+  if (total_packet_length > TXPACKET_MAX_LEN)
+    return 0;
+
+  txpacket[PKT_HEADER0]       = 0xFF;
+  txpacket[PKT_HEADER1]       = 0xFF;
+  txpacket[PKT_ID]            = BROADCAST_ID;
+  txpacket[PKT_LENGTH]        = param_length + 4; // 4: INST START_ADDR DATA_LEN ... CHKSUM
+  txpacket[PKT_INSTRUCTION]   = INST_SYNC_WRITE;
+  txpacket[PKT_PARAMETER0+0]  = start_address;
+  txpacket[PKT_PARAMETER0+1]  = data_length;
+
+  for (uint16_t s = 0; s < param_length; s++)
+    txpacket[PKT_PARAMETER0+2+s] = param[s];
+
+  for (uint16_t idx = 2; idx < total_packet_length - 1; idx++)   // except header, checksum
+    checksum += txpacket[idx];
+  txpacket[total_packet_length - 1] = ~checksum;
+
+  return total_packet_length;
+}
+
+bool Protocol1PacketHandler::updateSyncWritePacket(uint8_t *txpacket, uint16_t param_index, uint8_t *data, uint16_t length)
+{
+  uint16_t total_packet_length  = txpacket[PKT_LENGTH] + 4; // 4: HEADER0 HEADER1 ID LENGTH
+  uint16_t index                = PKT_PARAMETER0 + 2 + param_index;  // 2: START_ADDR DATA_LEN
+  uint8_t checksum              = ~txpacket[total_packet_length - 1];
+
+  for (uint16_t s = 0; s < length; s++)
+  {
+    checksum += data[s] - txpacket[index + s];
+    txpacket[index + s] = data[s];
+  }
+  txpacket[total_packet_length - 1] = ~checksum;
+
+  return true;
+}
+
+int Protocol1PacketHandler::txSyncWritePacket(PortHandler *port, uint8_t *txpacket)
+{
+  uint8_t total_packet_length   = txpacket[PKT_LENGTH] + 4; // 4: HEADER0 HEADER1 ID LENGTH
+  uint8_t written_packet_length = 0;
+
+  if (port->setUsing() == false)
+    return COMM_PORT_BUSY;
+
+  // tx packet
+  port->clearPort();
+  written_packet_length = port->writePort(txpacket, total_packet_length);
+  port->clearUsing();
+
+  if (total_packet_length != written_packet_length)
+    return COMM_TX_FAIL;
+
+  return COMM_SUCCESS;
+}
+
 int Protocol1PacketHandler::bulkReadTx(PortHandler *port, uint8_t *param, uint16_t param_length)
 {
   int result                 = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length+7);
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   // 7: HEADER0 HEADER1 ID LEN INST 0x00 ... CHKSUM
-  //uint8_t *txpacket           = new uint8_t[param_length + 7];
 
-  if (txpacket == NULL)
-    return result;
+  if (param_length+7 > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
 
   txpacket[PKT_ID]            = BROADCAST_ID;
   txpacket[PKT_LENGTH]        = param_length + 3; // 3: INST 0x00 ... CHKSUM
@@ -741,14 +861,18 @@ int Protocol1PacketHandler::bulkReadTx(PortHandler *port, uint8_t *param, uint16
     int wait_length = 0;
     for (uint16_t i = 0; i < param_length; i += 3)
       wait_length += param[i] + 7;
-    port->setPacketTimeout((uint16_t)wait_length);
+    port->setStatusPacketCount(param_length / 3);
+    port->setResponseTimeout(param[1], INST_BULK_READ, (uint16_t)wait_length);
   }
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
+int Protocol1PacketHandler::fastBulkReadTx(PortHandler *port, uint8_t *param, uint16_t param_length)
+{
+  return COMM_NOT_AVAILABLE;
+}
+
 int Protocol1PacketHandler::bulkWriteTxOnly(PortHandler *port, uint8_t *param, uint16_t param_length)
 {
   return COMM_NOT_AVAILABLE;
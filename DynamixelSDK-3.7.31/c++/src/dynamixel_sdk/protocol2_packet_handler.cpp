@@ -34,8 +34,13 @@
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#define TXPACKET_MAX_LEN    (PACKET_BUFFER_SIZE)
+#define RXPACKET_MAX_LEN    (PACKET_BUFFER_SIZE - 7)  // LENGTH of the longest status packet which fits the buffers of the port
+#else
 #define TXPACKET_MAX_LEN    (1*1024)
 #define RXPACKET_MAX_LEN    (1*1024)
+#endif
 
 ///////////////// for Protocol 2.0 Packet /////////////////
 #define PKT_HEADER0             0
@@ -60,6 +65,319 @@
 
 #define ERRBIT_ALERT            128     //When the device has a problem, this bit is set to 1. Check "Device Status Check" value.
 
+static const uint16_t CRC_TABLE[256] = {0x0000,
+  0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
+  0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027,
+  0x0022, 0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D,
+  0x8077, 0x0072, 0x0050, 0x8055, 0x805F, 0x005A, 0x804B,
+  0x004E, 0x0044, 0x8041, 0x80C3, 0x00C6, 0x00CC, 0x80C9,
+  0x00D8, 0x80DD, 0x80D7, 0x00D2, 0x00F0, 0x80F5, 0x80FF,
+  0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1, 0x00A0, 0x80A5,
+  0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1, 0x8093,
+  0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082,
+  0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197,
+  0x0192, 0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE,
+  0x01A4, 0x81A1, 0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB,
+  0x01FE, 0x01F4, 0x81F1, 0x81D3, 0x01D6, 0x01DC, 0x81D9,
+  0x01C8, 0x81CD, 0x81C7, 0x01C2, 0x0140, 0x8145, 0x814F,
+  0x014A, 0x815B, 0x015E, 0x0154, 0x8151, 0x8173, 0x0176,
+  0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162, 0x8123,
+  0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132,
+  0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104,
+  0x8101, 0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D,
+  0x8317, 0x0312, 0x0330, 0x8335, 0x833F, 0x033A, 0x832B,
+  0x032E, 0x0324, 0x8321, 0x0360, 0x8365, 0x836F, 0x036A,
+  0x837B, 0x037E, 0x0374, 0x8371, 0x8353, 0x0356, 0x035C,
+  0x8359, 0x0348, 0x834D, 0x8347, 0x0342, 0x03C0, 0x83C5,
+  0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1, 0x83F3,
+  0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2,
+  0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7,
+  0x03B2, 0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E,
+  0x0384, 0x8381, 0x0280, 0x8285, 0x828F, 0x028A, 0x829B,
+  0x029E, 0x0294, 0x8291, 0x82B3, 0x02B6, 0x02BC, 0x82B9,
+  0x02A8, 0x82AD, 0x82A7, 0x02A2, 0x82E3, 0x02E6, 0x02EC,
+  0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2, 0x02D0, 0x82D5,
+  0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1, 0x8243,
+  0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252,
+  0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264,
+  0x8261, 0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E,
+  0x0234, 0x8231, 0x8213, 0x0216, 0x021C, 0x8219, 0x0208,
+  0x820D, 0x8207, 0x0202 };
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+// [k-1][byte] : CRC16 of the byte followed by k zero bytes, for slicing-by-8 in updateCRC()
+// [k][b] = ([k-1][b] << 8) ^ CRC_TABLE[[k-1][b] >> 8], the boards with little flash keep CRC_TABLE only
+static const uint16_t CRC_SLICE_TABLE[7][256] = {
+  { // 1 zero byte
+    0x0000, 0x8603, 0x8C03, 0x0A00, 0x9803, 0x1E00, 0x1400, 0x9203,
+    0xB003, 0x3600, 0x3C00, 0xBA03, 0x2800, 0xAE03, 0xA403, 0x2200,
+    0xE003, 0x6600, 0x6C00, 0xEA03, 0x7800, 0xFE03, 0xF403, 0x7200,
+    0x5000, 0xD603, 0xDC03, 0x5A00, 0xC803, 0x4E00, 0x4400, 0xC203,
+    0x4003, 0xC600, 0xCC00, 0x4A03, 0xD800, 0x5E03, 0x5403, 0xD200,
+    0xF000, 0x7603, 0x7C03, 0xFA00, 0x6803, 0xEE00, 0xE400, 0x6203,
+    0xA000, 0x2603, 0x2C03, 0xAA00, 0x3803, 0xBE00, 0xB400, 0x3203,
+    0x1003, 0x9600, 0x9C00, 0x1A03, 0x8800, 0x0E03, 0x0403, 0x8200,
+    0x8006, 0x0605, 0x0C05, 0x8A06, 0x1805, 0x9E06, 0x9406, 0x1205,
+    0x3005, 0xB606, 0xBC06, 0x3A05, 0xA806, 0x2E05, 0x2405, 0xA206,
+    0x6005, 0xE606, 0xEC06, 0x6A05, 0xF806, 0x7E05, 0x7405, 0xF206,
+    0xD006, 0x5605, 0x5C05, 0xDA06, 0x4805, 0xCE06, 0xC406, 0x4205,
+    0xC005, 0x4606, 0x4C06, 0xCA05, 0x5806, 0xDE05, 0xD405, 0x5206,
+    0x7006, 0xF605, 0xFC05, 0x7A06, 0xE805, 0x6E06, 0x6406, 0xE205,
+    0x2006, 0xA605, 0xAC05, 0x2A06, 0xB805, 0x3E06, 0x3406, 0xB205,
+    0x9005, 0x1606, 0x1C06, 0x9A05, 0x0806, 0x8E05, 0x8405, 0x0206,
+    0x8009, 0x060A, 0x0C0A, 0x8A09, 0x180A, 0x9E09, 0x9409, 0x120A,
+    0x300A, 0xB609, 0xBC09, 0x3A0A, 0xA809, 0x2E0A, 0x240A, 0xA209,
+    0x600A, 0xE609, 0xEC09, 0x6A0A, 0xF809, 0x7E0A, 0x740A, 0xF209,
+    0xD009, 0x560A, 0x5C0A, 0xDA09, 0x480A, 0xCE09, 0xC409, 0x420A,
+    0xC00A, 0x4609, 0x4C09, 0xCA0A, 0x5809, 0xDE0A, 0xD40A, 0x5209,
+    0x7009, 0xF60A, 0xFC0A, 0x7A09, 0xE80A, 0x6E09, 0x6409, 0xE20A,
+    0x2009, 0xA60A, 0xAC0A, 0x2A09, 0xB80A, 0x3E09, 0x3409, 0xB20A,
+    0x900A, 0x1609, 0x1C09, 0x9A0A, 0x0809, 0x8E0A, 0x840A, 0x0209,
+    0x000F, 0x860C, 0x8C0C, 0x0A0F, 0x980C, 0x1E0F, 0x140F, 0x920C,
+    0xB00C, 0x360F, 0x3C0F, 0xBA0C, 0x280F, 0xAE0C, 0xA40C, 0x220F,
+    0xE00C, 0x660F, 0x6C0F, 0xEA0C, 0x780F, 0xFE0C, 0xF40C, 0x720F,
+    0x500F, 0xD60C, 0xDC0C, 0x5A0F, 0xC80C, 0x4E0F, 0x440F, 0xC20C,
+    0x400C, 0xC60F, 0xCC0F, 0x4A0C, 0xD80F, 0x5E0C, 0x540C, 0xD20F,
+    0xF00F, 0x760C, 0x7C0C, 0xFA0F, 0x680C, 0xEE0F, 0xE40F, 0x620C,
+    0xA00F, 0x260C, 0x2C0C, 0xAA0F, 0x380C, 0xBE0F, 0xB40F, 0x320C,
+    0x100C, 0x960F, 0x9C0F, 0x1A0C, 0x880F, 0x0E0C, 0x040C, 0x820F },
+  { // 2 zero bytes
+    0x0000, 0x8017, 0x802B, 0x003C, 0x8053, 0x0044, 0x0078, 0x806F,
+    0x80A3, 0x00B4, 0x0088, 0x809F, 0x00F0, 0x80E7, 0x80DB, 0x00CC,
+    0x8143, 0x0154, 0x0168, 0x817F, 0x0110, 0x8107, 0x813B, 0x012C,
+    0x01E0, 0x81F7, 0x81CB, 0x01DC, 0x81B3, 0x01A4, 0x0198, 0x818F,
+    0x8283, 0x0294, 0x02A8, 0x82BF, 0x02D0, 0x82C7, 0x82FB, 0x02EC,
+    0x0220, 0x8237, 0x820B, 0x021C, 0x8273, 0x0264, 0x0258, 0x824F,
+    0x03C0, 0x83D7, 0x83EB, 0x03FC, 0x8393, 0x0384, 0x03B8, 0x83AF,
+    0x8363, 0x0374, 0x0348, 0x835F, 0x0330, 0x8327, 0x831B, 0x030C,
+    0x8503, 0x0514, 0x0528, 0x853F, 0x0550, 0x8547, 0x857B, 0x056C,
+    0x05A0, 0x85B7, 0x858B, 0x059C, 0x85F3, 0x05E4, 0x05D8, 0x85CF,
+    0x0440, 0x8457, 0x846B, 0x047C, 0x8413, 0x0404, 0x0438, 0x842F,
+    0x84E3, 0x04F4, 0x04C8, 0x84DF, 0x04B0, 0x84A7, 0x849B, 0x048C,
+    0x0780, 0x8797, 0x87AB, 0x07BC, 0x87D3, 0x07C4, 0x07F8, 0x87EF,
+    0x8723, 0x0734, 0x0708, 0x871F, 0x0770, 0x8767, 0x875B, 0x074C,
+    0x86C3, 0x06D4, 0x06E8, 0x86FF, 0x0690, 0x8687, 0x86BB, 0x06AC,
+    0x0660, 0x8677, 0x864B, 0x065C, 0x8633, 0x0624, 0x0618, 0x860F,
+    0x8A03, 0x0A14, 0x0A28, 0x8A3F, 0x0A50, 0x8A47, 0x8A7B, 0x0A6C,
+    0x0AA0, 0x8AB7, 0x8A8B, 0x0A9C, 0x8AF3, 0x0AE4, 0x0AD8, 0x8ACF,
+    0x0B40, 0x8B57, 0x8B6B, 0x0B7C, 0x8B13, 0x0B04, 0x0B38, 0x8B2F,
+    0x8BE3, 0x0BF4, 0x0BC8, 0x8BDF, 0x0BB0, 0x8BA7, 0x8B9B, 0x0B8C,
+    0x0880, 0x8897, 0x88AB, 0x08BC, 0x88D3, 0x08C4, 0x08F8, 0x88EF,
+    0x8823, 0x0834, 0x0808, 0x881F, 0x0870, 0x8867, 0x885B, 0x084C,
+    0x89C3, 0x09D4, 0x09E8, 0x89FF, 0x0990, 0x8987, 0x89BB, 0x09AC,
+    0x0960, 0x8977, 0x894B, 0x095C, 0x8933, 0x0924, 0x0918, 0x890F,
+    0x0F00, 0x8F17, 0x8F2B, 0x0F3C, 0x8F53, 0x0F44, 0x0F78, 0x8F6F,
+    0x8FA3, 0x0FB4, 0x0F88, 0x8F9F, 0x0FF0, 0x8FE7, 0x8FDB, 0x0FCC,
+    0x8E43, 0x0E54, 0x0E68, 0x8E7F, 0x0E10, 0x8E07, 0x8E3B, 0x0E2C,
+    0x0EE0, 0x8EF7, 0x8ECB, 0x0EDC, 0x8EB3, 0x0EA4, 0x0E98, 0x8E8F,
+    0x8D83, 0x0D94, 0x0DA8, 0x8DBF, 0x0DD0, 0x8DC7, 0x8DFB, 0x0DEC,
+    0x0D20, 0x8D37, 0x8D0B, 0x0D1C, 0x8D73, 0x0D64, 0x0D58, 0x8D4F,
+    0x0CC0, 0x8CD7, 0x8CEB, 0x0CFC, 0x8C93, 0x0C84, 0x0CB8, 0x8CAF,
+    0x8C63, 0x0C74, 0x0C48, 0x8C5F, 0x0C30, 0x8C27, 0x8C1B, 0x0C0C },
+  { // 3 zero bytes
+    0x0000, 0x9403, 0xA803, 0x3C00, 0xD003, 0x4400, 0x7800, 0xEC03,
+    0x2003, 0xB400, 0x8800, 0x1C03, 0xF000, 0x6403, 0x5803, 0xCC00,
+    0x4006, 0xD405, 0xE805, 0x7C06, 0x9005, 0x0406, 0x3806, 0xAC05,
+    0x6005, 0xF406, 0xC806, 0x5C05, 0xB006, 0x2405, 0x1805, 0x8C06,
+    0x800C, 0x140F, 0x280F, 0xBC0C, 0x500F, 0xC40C, 0xF80C, 0x6C0F,
+    0xA00F, 0x340C, 0x080C, 0x9C0F, 0x700C, 0xE40F, 0xD80F, 0x4C0C,
+    0xC00A, 0x5409, 0x6809, 0xFC0A, 0x1009, 0x840A, 0xB80A, 0x2C09,
+    0xE009, 0x740A, 0x480A, 0xDC09, 0x300A, 0xA409, 0x9809, 0x0C0A,
+    0x801D, 0x141E, 0x281E, 0xBC1D, 0x501E, 0xC41D, 0xF81D, 0x6C1E,
+    0xA01E, 0x341D, 0x081D, 0x9C1E, 0x701D, 0xE41E, 0xD81E, 0x4C1D,
+    0xC01B, 0x5418, 0x6818, 0xFC1B, 0x1018, 0x841B, 0xB81B, 0x2C18,
+    0xE018, 0x741B, 0x481B, 0xDC18, 0x301B, 0xA418, 0x9818, 0x0C1B,
+    0x0011, 0x9412, 0xA812, 0x3C11, 0xD012, 0x4411, 0x7811, 0xEC12,
+    0x2012, 0xB411, 0x8811, 0x1C12, 0xF011, 0x6412, 0x5812, 0xCC11,
+    0x4017, 0xD414, 0xE814, 0x7C17, 0x9014, 0x0417, 0x3817, 0xAC14,
+    0x6014, 0xF417, 0xC817, 0x5C14, 0xB017, 0x2414, 0x1814, 0x8C17,
+    0x803F, 0x143C, 0x283C, 0xBC3F, 0x503C, 0xC43F, 0xF83F, 0x6C3C,
+    0xA03C, 0x343F, 0x083F, 0x9C3C, 0x703F, 0xE43C, 0xD83C, 0x4C3F,
+    0xC039, 0x543A, 0x683A, 0xFC39, 0x103A, 0x8439, 0xB839, 0x2C3A,
+    0xE03A, 0x7439, 0x4839, 0xDC3A, 0x3039, 0xA43A, 0x983A, 0x0C39,
+    0x0033, 0x9430, 0xA830, 0x3C33, 0xD030, 0x4433, 0x7833, 0xEC30,
+    0x2030, 0xB433, 0x8833, 0x1C30, 0xF033, 0x6430, 0x5830, 0xCC33,
+    0x4035, 0xD436, 0xE836, 0x7C35, 0x9036, 0x0435, 0x3835, 0xAC36,
+    0x6036, 0xF435, 0xC835, 0x5C36, 0xB035, 0x2436, 0x1836, 0x8C35,
+    0x0022, 0x9421, 0xA821, 0x3C22, 0xD021, 0x4422, 0x7822, 0xEC21,
+    0x2021, 0xB422, 0x8822, 0x1C21, 0xF022, 0x6421, 0x5821, 0xCC22,
+    0x4024, 0xD427, 0xE827, 0x7C24, 0x9027, 0x0424, 0x3824, 0xAC27,
+    0x6027, 0xF424, 0xC824, 0x5C27, 0xB024, 0x2427, 0x1827, 0x8C24,
+    0x802E, 0x142D, 0x282D, 0xBC2E, 0x502D, 0xC42E, 0xF82E, 0x6C2D,
+    0xA02D, 0x342E, 0x082E, 0x9C2D, 0x702E, 0xE42D, 0xD82D, 0x4C2E,
+    0xC028, 0x542B, 0x682B, 0xFC28, 0x102B, 0x8428, 0xB828, 0x2C2B,
+    0xE02B, 0x7428, 0x4828, 0xDC2B, 0x3028, 0xA42B, 0x982B, 0x0C28 },
+  { // 4 zero bytes
+    0x0000, 0x807B, 0x80F3, 0x0088, 0x81E3, 0x0198, 0x0110, 0x816B,
+    0x83C3, 0x03B8, 0x0330, 0x834B, 0x0220, 0x825B, 0x82D3, 0x02A8,
+    0x8783, 0x07F8, 0x0770, 0x870B, 0x0660, 0x861B, 0x8693, 0x06E8,
+    0x0440, 0x843B, 0x84B3, 0x04C8, 0x85A3, 0x05D8, 0x0550, 0x852B,
+    0x8F03, 0x0F78, 0x0FF0, 0x8F8B, 0x0EE0, 0x8E9B, 0x8E13, 0x0E68,
+    0x0CC0, 0x8CBB, 0x8C33, 0x0C48, 0x8D23, 0x0D58, 0x0DD0, 0x8DAB,
+    0x0880, 0x88FB, 0x8873, 0x0808, 0x8963, 0x0918, 0x0990, 0x89EB,
+    0x8B43, 0x0B38, 0x0BB0, 0x8BCB, 0x0AA0, 0x8ADB, 0x8A53, 0x0A28,
+    0x9E03, 0x1E78, 0x1EF0, 0x9E8B, 0x1FE0, 0x9F9B, 0x9F13, 0x1F68,
+    0x1DC0, 0x9DBB, 0x9D33, 0x1D48, 0x9C23, 0x1C58, 0x1CD0, 0x9CAB,
+    0x1980, 0x99FB, 0x9973, 0x1908, 0x9863, 0x1818, 0x1890, 0x98EB,
+    0x9A43, 0x1A38, 0x1AB0, 0x9ACB, 0x1BA0, 0x9BDB, 0x9B53, 0x1B28,
+    0x1100, 0x917B, 0x91F3, 0x1188, 0x90E3, 0x1098, 0x1010, 0x906B,
+    0x92C3, 0x12B8, 0x1230, 0x924B, 0x1320, 0x935B, 0x93D3, 0x13A8,
+    0x9683, 0x16F8, 0x1670, 0x960B, 0x1760, 0x971B, 0x9793, 0x17E8,
+    0x1540, 0x953B, 0x95B3, 0x15C8, 0x94A3, 0x14D8, 0x1450, 0x942B,
+    0xBC03, 0x3C78, 0x3CF0, 0xBC8B, 0x3DE0, 0xBD9B, 0xBD13, 0x3D68,
+    0x3FC0, 0xBFBB, 0xBF33, 0x3F48, 0xBE23, 0x3E58, 0x3ED0, 0xBEAB,
+    0x3B80, 0xBBFB, 0xBB73, 0x3B08, 0xBA63, 0x3A18, 0x3A90, 0xBAEB,
+    0xB843, 0x3838, 0x38B0, 0xB8CB, 0x39A0, 0xB9DB, 0xB953, 0x3928,
+    0x3300, 0xB37B, 0xB3F3, 0x3388, 0xB2E3, 0x3298, 0x3210, 0xB26B,
+    0xB0C3, 0x30B8, 0x3030, 0xB04B, 0x3120, 0xB15B, 0xB1D3, 0x31A8,
+    0xB483, 0x34F8, 0x3470, 0xB40B, 0x3560, 0xB51B, 0xB593, 0x35E8,
+    0x3740, 0xB73B, 0xB7B3, 0x37C8, 0xB6A3, 0x36D8, 0x3650, 0xB62B,
+    0x2200, 0xA27B, 0xA2F3, 0x2288, 0xA3E3, 0x2398, 0x2310, 0xA36B,
+    0xA1C3, 0x21B8, 0x2130, 0xA14B, 0x2020, 0xA05B, 0xA0D3, 0x20A8,
+    0xA583, 0x25F8, 0x2570, 0xA50B, 0x2460, 0xA41B, 0xA493, 0x24E8,
+    0x2640, 0xA63B, 0xA6B3, 0x26C8, 0xA7A3, 0x27D8, 0x2750, 0xA72B,
+    0xAD03, 0x2D78, 0x2DF0, 0xAD8B, 0x2CE0, 0xAC9B, 0xAC13, 0x2C68,
+    0x2EC0, 0xAEBB, 0xAE33, 0x2E48, 0xAF23, 0x2F58, 0x2FD0, 0xAFAB,
+    0x2A80, 0xAAFB, 0xAA73, 0x2A08, 0xAB63, 0x2B18, 0x2B90, 0xABEB,
+    0xA943, 0x2938, 0x29B0, 0xA9CB, 0x28A0, 0xA8DB, 0xA853, 0x2828 },
+  { // 5 zero bytes
+    0x0000, 0xF803, 0x7003, 0x8800, 0xE006, 0x1805, 0x9005, 0x6806,
+    0x4009, 0xB80A, 0x300A, 0xC809, 0xA00F, 0x580C, 0xD00C, 0x280F,
+    0x8012, 0x7811, 0xF011, 0x0812, 0x6014, 0x9817, 0x1017, 0xE814,
+    0xC01B, 0x3818, 0xB018, 0x481B, 0x201D, 0xD81E, 0x501E, 0xA81D,
+    0x8021, 0x7822, 0xF022, 0x0821, 0x6027, 0x9824, 0x1024, 0xE827,
+    0xC028, 0x382B, 0xB02B, 0x4828, 0x202E, 0xD82D, 0x502D, 0xA82E,
+    0x0033, 0xF830, 0x7030, 0x8833, 0xE035, 0x1836, 0x9036, 0x6835,
+    0x403A, 0xB839, 0x3039, 0xC83A, 0xA03C, 0x583F, 0xD03F, 0x283C,
+    0x8047, 0x7844, 0xF044, 0x0847, 0x6041, 0x9842, 0x1042, 0xE841,
+    0xC04E, 0x384D, 0xB04D, 0x484E, 0x2048, 0xD84B, 0x504B, 0xA848,
+    0x0055, 0xF856, 0x7056, 0x8855, 0xE053, 0x1850, 0x9050, 0x6853,
+    0x405C, 0xB85F, 0x305F, 0xC85C, 0xA05A, 0x5859, 0xD059, 0x285A,
+    0x0066, 0xF865, 0x7065, 0x8866, 0xE060, 0x1863, 0x9063, 0x6860,
+    0x406F, 0xB86C, 0x306C, 0xC86F, 0xA069, 0x586A, 0xD06A, 0x2869,
+    0x8074, 0x7877, 0xF077, 0x0874, 0x6072, 0x9871, 0x1071, 0xE872,
+    0xC07D, 0x387E, 0xB07E, 0x487D, 0x207B, 0xD878, 0x5078, 0xA87B,
+    0x808B, 0x7888, 0xF088, 0x088B, 0x608D, 0x988E, 0x108E, 0xE88D,
+    0xC082, 0x3881, 0xB081, 0x4882, 0x2084, 0xD887, 0x5087, 0xA884,
+    0x0099, 0xF89A, 0x709A, 0x8899, 0xE09F, 0x189C, 0x909C, 0x689F,
+    0x4090, 0xB893, 0x3093, 0xC890, 0xA096, 0x5895, 0xD095, 0x2896,
+    0x00AA, 0xF8A9, 0x70A9, 0x88AA, 0xE0AC, 0x18AF, 0x90AF, 0x68AC,
+    0x40A3, 0xB8A0, 0x30A0, 0xC8A3, 0xA0A5, 0x58A6, 0xD0A6, 0x28A5,
+    0x80B8, 0x78BB, 0xF0BB, 0x08B8, 0x60BE, 0x98BD, 0x10BD, 0xE8BE,
+    0xC0B1, 0x38B2, 0xB0B2, 0x48B1, 0x20B7, 0xD8B4, 0x50B4, 0xA8B7,
+    0x00CC, 0xF8CF, 0x70CF, 0x88CC, 0xE0CA, 0x18C9, 0x90C9, 0x68CA,
+    0x40C5, 0xB8C6, 0x30C6, 0xC8C5, 0xA0C3, 0x58C0, 0xD0C0, 0x28C3,
+    0x80DE, 0x78DD, 0xF0DD, 0x08DE, 0x60D8, 0x98DB, 0x10DB, 0xE8D8,
+    0xC0D7, 0x38D4, 0xB0D4, 0x48D7, 0x20D1, 0xD8D2, 0x50D2, 0xA8D1,
+    0x80ED, 0x78EE, 0xF0EE, 0x08ED, 0x60EB, 0x98E8, 0x10E8, 0xE8EB,
+    0xC0E4, 0x38E7, 0xB0E7, 0x48E4, 0x20E2, 0xD8E1, 0x50E1, 0xA8E2,
+    0x00FF, 0xF8FC, 0x70FC, 0x88FF, 0xE0F9, 0x18FA, 0x90FA, 0x68F9,
+    0x40F6, 0xB8F5, 0x30F5, 0xC8F6, 0xA0F0, 0x58F3, 0xD0F3, 0x28F0 },
+  { // 6 zero bytes
+    0x0000, 0x8113, 0x8223, 0x0330, 0x8443, 0x0550, 0x0660, 0x8773,
+    0x8883, 0x0990, 0x0AA0, 0x8BB3, 0x0CC0, 0x8DD3, 0x8EE3, 0x0FF0,
+    0x9103, 0x1010, 0x1320, 0x9233, 0x1540, 0x9453, 0x9763, 0x1670,
+    0x1980, 0x9893, 0x9BA3, 0x1AB0, 0x9DC3, 0x1CD0, 0x1FE0, 0x9EF3,
+    0xA203, 0x2310, 0x2020, 0xA133, 0x2640, 0xA753, 0xA463, 0x2570,
+    0x2A80, 0xAB93, 0xA8A3, 0x29B0, 0xAEC3, 0x2FD0, 0x2CE0, 0xADF3,
+    0x3300, 0xB213, 0xB123, 0x3030, 0xB743, 0x3650, 0x3560, 0xB473,
+    0xBB83, 0x3A90, 0x39A0, 0xB8B3, 0x3FC0, 0xBED3, 0xBDE3, 0x3CF0,
+    0xC403, 0x4510, 0x4620, 0xC733, 0x4040, 0xC153, 0xC263, 0x4370,
+    0x4C80, 0xCD93, 0xCEA3, 0x4FB0, 0xC8C3, 0x49D0, 0x4AE0, 0xCBF3,
+    0x5500, 0xD413, 0xD723, 0x5630, 0xD143, 0x5050, 0x5360, 0xD273,
+    0xDD83, 0x5C90, 0x5FA0, 0xDEB3, 0x59C0, 0xD8D3, 0xDBE3, 0x5AF0,
+    0x6600, 0xE713, 0xE423, 0x6530, 0xE243, 0x6350, 0x6060, 0xE173,
+    0xEE83, 0x6F90, 0x6CA0, 0xEDB3, 0x6AC0, 0xEBD3, 0xE8E3, 0x69F0,
+    0xF703, 0x7610, 0x7520, 0xF433, 0x7340, 0xF253, 0xF163, 0x7070,
+    0x7F80, 0xFE93, 0xFDA3, 0x7CB0, 0xFBC3, 0x7AD0, 0x79E0, 0xF8F3,
+    0x0803, 0x8910, 0x8A20, 0x0B33, 0x8C40, 0x0D53, 0x0E63, 0x8F70,
+    0x8080, 0x0193, 0x02A3, 0x83B0, 0x04C3, 0x85D0, 0x86E0, 0x07F3,
+    0x9900, 0x1813, 0x1B23, 0x9A30, 0x1D43, 0x9C50, 0x9F60, 0x1E73,
+    0x1183, 0x9090, 0x93A0, 0x12B3, 0x95C0, 0x14D3, 0x17E3, 0x96F0,
+    0xAA00, 0x2B13, 0x2823, 0xA930, 0x2E43, 0xAF50, 0xAC60, 0x2D73,
+    0x2283, 0xA390, 0xA0A0, 0x21B3, 0xA6C0, 0x27D3, 0x24E3, 0xA5F0,
+    0x3B03, 0xBA10, 0xB920, 0x3833, 0xBF40, 0x3E53, 0x3D63, 0xBC70,
+    0xB380, 0x3293, 0x31A3, 0xB0B0, 0x37C3, 0xB6D0, 0xB5E0, 0x34F3,
+    0xCC00, 0x4D13, 0x4E23, 0xCF30, 0x4843, 0xC950, 0xCA60, 0x4B73,
+    0x4483, 0xC590, 0xC6A0, 0x47B3, 0xC0C0, 0x41D3, 0x42E3, 0xC3F0,
+    0x5D03, 0xDC10, 0xDF20, 0x5E33, 0xD940, 0x5853, 0x5B63, 0xDA70,
+    0xD580, 0x5493, 0x57A3, 0xD6B0, 0x51C3, 0xD0D0, 0xD3E0, 0x52F3,
+    0x6E03, 0xEF10, 0xEC20, 0x6D33, 0xEA40, 0x6B53, 0x6863, 0xE970,
+    0xE680, 0x6793, 0x64A3, 0xE5B0, 0x62C3, 0xE3D0, 0xE0E0, 0x61F3,
+    0xFF00, 0x7E13, 0x7D23, 0xFC30, 0x7B43, 0xFA50, 0xF960, 0x7873,
+    0x7783, 0xF690, 0xF5A0, 0x74B3, 0xF3C0, 0x72D3, 0x71E3, 0xF0F0 },
+  { // 7 zero bytes
+    0x0000, 0x1006, 0x200C, 0x300A, 0x4018, 0x501E, 0x6014, 0x7012,
+    0x8030, 0x9036, 0xA03C, 0xB03A, 0xC028, 0xD02E, 0xE024, 0xF022,
+    0x8065, 0x9063, 0xA069, 0xB06F, 0xC07D, 0xD07B, 0xE071, 0xF077,
+    0x0055, 0x1053, 0x2059, 0x305F, 0x404D, 0x504B, 0x6041, 0x7047,
+    0x80CF, 0x90C9, 0xA0C3, 0xB0C5, 0xC0D7, 0xD0D1, 0xE0DB, 0xF0DD,
+    0x00FF, 0x10F9, 0x20F3, 0x30F5, 0x40E7, 0x50E1, 0x60EB, 0x70ED,
+    0x00AA, 0x10AC, 0x20A6, 0x30A0, 0x40B2, 0x50B4, 0x60BE, 0x70B8,
+    0x809A, 0x909C, 0xA096, 0xB090, 0xC082, 0xD084, 0xE08E, 0xF088,
+    0x819B, 0x919D, 0xA197, 0xB191, 0xC183, 0xD185, 0xE18F, 0xF189,
+    0x01AB, 0x11AD, 0x21A7, 0x31A1, 0x41B3, 0x51B5, 0x61BF, 0x71B9,
+    0x01FE, 0x11F8, 0x21F2, 0x31F4, 0x41E6, 0x51E0, 0x61EA, 0x71EC,
+    0x81CE, 0x91C8, 0xA1C2, 0xB1C4, 0xC1D6, 0xD1D0, 0xE1DA, 0xF1DC,
+    0x0154, 0x1152, 0x2158, 0x315E, 0x414C, 0x514A, 0x6140, 0x7146,
+    0x8164, 0x9162, 0xA168, 0xB16E, 0xC17C, 0xD17A, 0xE170, 0xF176,
+    0x8131, 0x9137, 0xA13D, 0xB13B, 0xC129, 0xD12F, 0xE125, 0xF123,
+    0x0101, 0x1107, 0x210D, 0x310B, 0x4119, 0x511F, 0x6115, 0x7113,
+    0x8333, 0x9335, 0xA33F, 0xB339, 0xC32B, 0xD32D, 0xE327, 0xF321,
+    0x0303, 0x1305, 0x230F, 0x3309, 0x431B, 0x531D, 0x6317, 0x7311,
+    0x0356, 0x1350, 0x235A, 0x335C, 0x434E, 0x5348, 0x6342, 0x7344,
+    0x8366, 0x9360, 0xA36A, 0xB36C, 0xC37E, 0xD378, 0xE372, 0xF374,
+    0x03FC, 0x13FA, 0x23F0, 0x33F6, 0x43E4, 0x53E2, 0x63E8, 0x73EE,
+    0x83CC, 0x93CA, 0xA3C0, 0xB3C6, 0xC3D4, 0xD3D2, 0xE3D8, 0xF3DE,
+    0x8399, 0x939F, 0xA395, 0xB393, 0xC381, 0xD387, 0xE38D, 0xF38B,
+    0x03A9, 0x13AF, 0x23A5, 0x33A3, 0x43B1, 0x53B7, 0x63BD, 0x73BB,
+    0x02A8, 0x12AE, 0x22A4, 0x32A2, 0x42B0, 0x52B6, 0x62BC, 0x72BA,
+    0x8298, 0x929E, 0xA294, 0xB292, 0xC280, 0xD286, 0xE28C, 0xF28A,
+    0x82CD, 0x92CB, 0xA2C1, 0xB2C7, 0xC2D5, 0xD2D3, 0xE2D9, 0xF2DF,
+    0x02FD, 0x12FB, 0x22F1, 0x32F7, 0x42E5, 0x52E3, 0x62E9, 0x72EF,
+    0x8267, 0x9261, 0xA26B, 0xB26D, 0xC27F, 0xD279, 0xE273, 0xF275,
+    0x0257, 0x1251, 0x225B, 0x325D, 0x424F, 0x5249, 0x6243, 0x7245,
+    0x0202, 0x1204, 0x220E, 0x3208, 0x421A, 0x521C, 0x6216, 0x7210,
+    0x8232, 0x9234, 0xA23E, 0xB238, 0xC22A, 0xD22C, 0xE226, 0xF220 } };
+#endif
+
+// [n][bit] : CRC16 of the bit followed by 2^n zero bytes, for shiftCRC()
+// a zero byte after the CRC16 is a linear map of its bits, and 2^(n+1) zero bytes apply the map of 2^n twice
+static const uint16_t CRC_SHIFT_TABLE[11][16] = {
+  { // 1 zero byte
+    0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000,
+    0x8005, 0x800F, 0x801B, 0x8033, 0x8063, 0x80C3, 0x8183, 0x8303 },
+  { // 2 zero bytes
+    0x8005, 0x800F, 0x801B, 0x8033, 0x8063, 0x80C3, 0x8183, 0x8303,
+    0x8603, 0x8C03, 0x9803, 0xB003, 0xE003, 0x4003, 0x8006, 0x8009 },
+  { // 4 zero bytes
+    0x8017, 0x802B, 0x8053, 0x80A3, 0x8143, 0x8283, 0x8503, 0x8A03,
+    0x9403, 0xA803, 0xD003, 0x2003, 0x4006, 0x800C, 0x801D, 0x803F },
+  { // 8 zero bytes
+    0x8113, 0x8223, 0x8443, 0x8883, 0x9103, 0xA203, 0xC403, 0x0803,
+    0x1006, 0x200C, 0x4018, 0x8030, 0x8065, 0x80CF, 0x819B, 0x8333 },
+  { // 16 zero bytes
+    0x0106, 0x020C, 0x0418, 0x0830, 0x1060, 0x20C0, 0x4180, 0x8300,
+    0x8605, 0x8C0F, 0x981B, 0xB033, 0xE063, 0x40C3, 0x8186, 0x8309 },
+  { // 32 zero bytes
+    0x8011, 0x8027, 0x804B, 0x8093, 0x8123, 0x8243, 0x8483, 0x8903,
+    0x9203, 0xA403, 0xC803, 0x1003, 0x2006, 0x400C, 0x8018, 0x8035 },
+  { // 64 zero bytes
+    0x8107, 0x820B, 0x8413, 0x8823, 0x9043, 0xA083, 0xC103, 0x0203,
+    0x0406, 0x080C, 0x1018, 0x2030, 0x4060, 0x80C0, 0x8185, 0x830F },
+  { // 128 zero bytes
+    0x0016, 0x002C, 0x0058, 0x00B0, 0x0160, 0x02C0, 0x0580, 0x0B00,
+    0x1600, 0x2C00, 0x5800, 0xB000, 0xE005, 0x400F, 0x801E, 0x8039 },
+  { // 256 zero bytes
+    0x0114, 0x0228, 0x0450, 0x08A0, 0x1140, 0x2280, 0x4500, 0x8A00,
+    0x9405, 0xA80F, 0xD01B, 0x2033, 0x4066, 0x80CC, 0x819D, 0x833F },
+  { // 512 zero bytes
+    0x8115, 0x822F, 0x845B, 0x88B3, 0x9163, 0xA2C3, 0xC583, 0x0B03,
+    0x1606, 0x2C0C, 0x5818, 0xB030, 0xE065, 0x40CF, 0x819E, 0x8339 },
+  { // 1024 zero bytes
+    0x0112, 0x0224, 0x0448, 0x0890, 0x1120, 0x2240, 0x4480, 0x8900,
+    0x9205, 0xA40F, 0xC81B, 0x1033, 0x2066, 0x40CC, 0x8198, 0x8335 } };
+
 using namespace dynamixel;
 
 Protocol2PacketHandler *Protocol2PacketHandler::unique_instance_ = new Protocol2PacketHandler();
@@ -143,92 +461,91 @@ const char *Protocol2PacketHandler::getRxPacketError(uint8_t error)
 unsigned short Protocol2PacketHandler::updateCRC(uint16_t crc_accum, uint8_t *data_blk_ptr, uint16_t data_blk_size)
 {
   uint16_t i;
-  static const uint16_t crc_table[256] = {0x0000,
-  0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
-  0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027,
-  0x0022, 0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D,
-  0x8077, 0x0072, 0x0050, 0x8055, 0x805F, 0x005A, 0x804B,
-  0x004E, 0x0044, 0x8041, 0x80C3, 0x00C6, 0x00CC, 0x80C9,
-  0x00D8, 0x80DD, 0x80D7, 0x00D2, 0x00F0, 0x80F5, 0x80FF,
-  0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1, 0x00A0, 0x80A5,
-  0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1, 0x8093,
-  0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082,
-  0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197,
-  0x0192, 0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE,
-  0x01A4, 0x81A1, 0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB,
-  0x01FE, 0x01F4, 0x81F1, 0x81D3, 0x01D6, 0x01DC, 0x81D9,
-  0x01C8, 0x81CD, 0x81C7, 0x01C2, 0x0140, 0x8145, 0x814F,
-  0x014A, 0x815B, 0x015E, 0x0154, 0x8151, 0x8173, 0x0176,
-  0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162, 0x8123,
-  0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132,
-  0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104,
-  0x8101, 0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D,
-  0x8317, 0x0312, 0x0330, 0x8335, 0x833F, 0x033A, 0x832B,
-  0x032E, 0x0324, 0x8321, 0x0360, 0x8365, 0x836F, 0x036A,
-  0x837B, 0x037E, 0x0374, 0x8371, 0x8353, 0x0356, 0x035C,
-  0x8359, 0x0348, 0x834D, 0x8347, 0x0342, 0x03C0, 0x83C5,
-  0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1, 0x83F3,
-  0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2,
-  0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7,
-  0x03B2, 0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E,
-  0x0384, 0x8381, 0x0280, 0x8285, 0x828F, 0x028A, 0x829B,
-  0x029E, 0x0294, 0x8291, 0x82B3, 0x02B6, 0x02BC, 0x82B9,
-  0x02A8, 0x82AD, 0x82A7, 0x02A2, 0x82E3, 0x02E6, 0x02EC,
-  0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2, 0x02D0, 0x82D5,
-  0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1, 0x8243,
-  0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252,
-  0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264,
-  0x8261, 0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E,
-  0x0234, 0x8231, 0x8213, 0x0216, 0x021C, 0x8219, 0x0208,
-  0x820D, 0x8207, 0x0202 };
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+  // slicing-by-8 : the CRC16 goes into the first two bytes, and each byte of the block is looked up
+  // with the number of bytes following it
+  for (; data_blk_size >= 8; data_blk_size -= 8, data_blk_ptr += 8)
+  {
+    crc_accum = CRC_SLICE_TABLE[6][((crc_accum >> 8) ^ data_blk_ptr[0]) & 0xFF] ^
+                CRC_SLICE_TABLE[5][(crc_accum ^ data_blk_ptr[1]) & 0xFF] ^
+                CRC_SLICE_TABLE[4][data_blk_ptr[2]] ^
+                CRC_SLICE_TABLE[3][data_blk_ptr[3]] ^
+                CRC_SLICE_TABLE[2][data_blk_ptr[4]] ^
+                CRC_SLICE_TABLE[1][data_blk_ptr[5]] ^
+                CRC_SLICE_TABLE[0][data_blk_ptr[6]] ^
+                CRC_TABLE[data_blk_ptr[7]];
+  }
+#endif
 
   for (uint16_t j = 0; j < data_blk_size; j++)
   {
     i = ((uint16_t)(crc_accum >> 8) ^ *data_blk_ptr++) & 0xFF;
-    crc_accum = (crc_accum << 8) ^ crc_table[i];
+    crc_accum = (crc_accum << 8) ^ CRC_TABLE[i];
+  }
+
+  return crc_accum;
+}
+
+uint16_t Protocol2PacketHandler::shiftCRC(uint16_t crc_accum, uint16_t zero_length)
+{
+  // same as updateCRC() with zero_length zero bytes, for a packet shorter than 2048 bytes
+  for (int n = 0; n < 11 && zero_length != 0; n++, zero_length >>= 1)
+  {
+    if ((zero_length & 1) == 0)
+      continue;
+
+    uint16_t out = 0;
+    for (int b = 0; b < 16; b++)
+    {
+      if (crc_accum & (1 << b))
+        out ^= CRC_SHIFT_TABLE[n][b];
+    }
+    crc_accum = out;
   }
 
   return crc_accum;
 }
 
+uint16_t Protocol2PacketHandler::findHeader(uint8_t *data, uint16_t length)
+{
+  // 0xFD is the rarest byte of FF FF FD, so it is looked for by memchr() which the C library vectorizes
+  for (uint16_t i = 2; i < length; i++)
+  {
+    uint8_t *fd = (uint8_t *)memchr(&data[i], 0xFD, length - i);
+    if (fd == NULL)
+      break;
+
+    i = (uint16_t)(fd - data);
+    if (data[i-1] == 0xFF && data[i-2] == 0xFF)
+      return i - 2;
+  }
+
+  return length;
+}
+
 void Protocol2PacketHandler::addStuffing(uint8_t *packet)
 {
   int packet_length_in = DXL_MAKEWORD(packet[PKT_LENGTH_L], packet[PKT_LENGTH_H]);
   int packet_length_out = packet_length_in;
-  
+
   if (packet_length_in < 8) // INSTRUCTION, ADDR_L, ADDR_H, CRC16_L, CRC16_H + FF FF FD
     return;
 
-  uint8_t *packet_ptr;
-  uint16_t packet_length_before_crc = packet_length_in - 2;
-  for (uint16_t i = 3; i < packet_length_before_crc; i++)
+  // one pass : the bytes after each FF FF FD are moved back by one and 0xFD is put in between
+  uint16_t index = PKT_PARAMETER0;
+  uint16_t end   = packet_length_in + 6 - 2 + 1;  // next to the last index before crc
+  while (true)
   {
-    packet_ptr = &packet[i+PKT_INSTRUCTION-2];
-    if (packet_ptr[0] == 0xFF && packet_ptr[1] == 0xFF && packet_ptr[2] == 0xFD)
-      packet_length_out++;
-  }
-  
-  if (packet_length_in == packet_length_out)  // no stuffing required
-    return;
-  
-  uint16_t out_index  = packet_length_out + 6 - 2;  // last index before crc
-  uint16_t in_index   = packet_length_in + 6 - 2;   // last index before crc
-  while (out_index != in_index)
-  {
-    if (packet[in_index] == 0xFD && packet[in_index-1] == 0xFF && packet[in_index-2] == 0xFF)
-    {
-      packet[out_index--] = 0xFD; // byte stuffing
-      if (out_index != in_index)
-      {
-        packet[out_index--] = packet[in_index--]; // FD
-        packet[out_index--] = packet[in_index--]; // FF
-        packet[out_index--] = packet[in_index--]; // FF
-      }
-    }
-    else
-    {
-      packet[out_index--] = packet[in_index--];
-    }
+    index += findHeader(&packet[index], end - index);
+    if (index == end)
+      break;
+
+    memmove(&packet[index + 4], &packet[index + 3], end - (index + 3));
+    packet[index + 3] = 0xFD; // byte stuffing
+    index += 4;
+    end++;
+    packet_length_out++;
   }
 
   packet[PKT_LENGTH_L] = DXL_LOBYTE(packet_length_out);
@@ -239,22 +556,30 @@ void Protocol2PacketHandler::addStuffing(uint8_t *packet)
 
 void Protocol2PacketHandler::removeStuffing(uint8_t *packet)
 {
-  int i = 0, index = 0;
   int packet_length_in = DXL_MAKEWORD(packet[PKT_LENGTH_L], packet[PKT_LENGTH_H]);
   int packet_length_out = packet_length_in;
 
-  index = PKT_INSTRUCTION;
-  for (i = 0; i < packet_length_in - 2; i++)  // except CRC
+  // one pass : the bytes between the stuffed 0xFD are moved forward, the CRC16 is moved with the last ones
+  uint16_t in_index  = PKT_INSTRUCTION;
+  uint16_t out_index = PKT_INSTRUCTION;
+  uint16_t index     = PKT_INSTRUCTION - 2;
+  uint16_t end       = PKT_INSTRUCTION + packet_length_in - 2;  // CRC16_L
+  while (true)
   {
-    if (packet[i+PKT_INSTRUCTION] == 0xFD && packet[i+PKT_INSTRUCTION+1] == 0xFD && packet[i+PKT_INSTRUCTION-1] == 0xFF && packet[i+PKT_INSTRUCTION-2] == 0xFF)
+    index += findHeader(&packet[index], end - index);
+    if (index + 3 >= end)
+      break;
+
+    if (packet[index + 3] == 0xFD)
     {   // FF FF FD FD
+      memmove(&packet[out_index], &packet[in_index], index + 3 - in_index);
+      out_index += index + 3 - in_index;
+      in_index   = index + 4;
       packet_length_out--;
-      i++;
     }
-    packet[index++] = packet[i+PKT_INSTRUCTION];
+    index += 3;
   }
-  packet[index++] = packet[PKT_INSTRUCTION+packet_length_in-2];
-  packet[index++] = packet[PKT_INSTRUCTION+packet_length_in-1];
+  memmove(&packet[out_index], &packet[in_index], end + 2 - in_index);
 
   packet[PKT_LENGTH_L] = DXL_LOBYTE(packet_length_out);
   packet[PKT_LENGTH_H] = DXL_HIBYTE(packet_length_out);
@@ -265,9 +590,8 @@ int Protocol2PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
   uint16_t total_packet_length   = 0;
   uint16_t written_packet_length = 0;
 
-  if (port->is_using_)
+  if (port->setUsing() == false)
     return COMM_PORT_BUSY;
-  port->is_using_ = true;
 
   // byte stuffing for header
   addStuffing(txpacket);
@@ -277,7 +601,7 @@ int Protocol2PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
   // 7: HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H
   if (total_packet_length > TXPACKET_MAX_LEN)
   {
-    port->is_using_ = false;
+    port->clearUsing();
     return COMM_TX_ERROR;
   }
 
@@ -297,23 +621,25 @@ int Protocol2PacketHandler::txPacket(PortHandler *port, uint8_t *txpacket)
   written_packet_length = port->writePort(txpacket, total_packet_length);
   if (total_packet_length != written_packet_length)
   {
-    port->is_using_ = false;
+    port->clearUsing();
     return COMM_TX_FAIL;
   }
 
   return COMM_SUCCESS;
 }
 
-int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
+int Protocol2PacketHandler::pollStatusPacket(PortHandler *port, uint8_t *rxpacket)
 {
-  int     result         = COMM_TX_FAIL;
+  int     result         = COMM_RX_WAITING;
 
   uint16_t rx_length     = 0;
   uint16_t wait_length   = 11; // minimum length (HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST ERROR CRC16_L CRC16_H)
 
   while(true)
   {
-    rx_length += port->readPort(&rxpacket[rx_length], wait_length - rx_length);
+    // the bytes stay in the receive buffer of the port until a whole packet is found
+    port->fillRxBuffer();
+    rx_length = port->getRxBufferLength();
     if (rx_length >= wait_length)
     {
       uint16_t idx = 0;
@@ -321,72 +647,62 @@ int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
       // find packet header
       for (idx = 0; idx < (rx_length - 3); idx++)
       {
-        if ((rxpacket[idx] == 0xFF) && (rxpacket[idx+1] == 0xFF) && (rxpacket[idx+2] == 0xFD) && (rxpacket[idx+3] != 0xFD))
+        if ((port->peekRxBuffer(idx) == 0xFF) && (port->peekRxBuffer(idx+1) == 0xFF) && (port->peekRxBuffer(idx+2) == 0xFD) && (port->peekRxBuffer(idx+3) != 0xFD))
           break;
       }
 
       if (idx == 0)   // found at the beginning of the packet
       {
-        if (rxpacket[PKT_RESERVED] != 0x00 ||
-           rxpacket[PKT_ID] > 0xFC ||
-           DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) > RXPACKET_MAX_LEN ||
-           rxpacket[PKT_INSTRUCTION] != 0x55)
+        uint16_t length = DXL_MAKEWORD(port->peekRxBuffer(PKT_LENGTH_L), port->peekRxBuffer(PKT_LENGTH_H));
+
+        if (port->peekRxBuffer(PKT_RESERVED) != 0x00 ||
+           (port->peekRxBuffer(PKT_ID) > 0xFC && port->peekRxBuffer(PKT_ID) != BROADCAST_ID) ||  // BROADCAST_ID for Fast Sync/Bulk Read
+           length > RXPACKET_MAX_LEN ||
+           port->peekRxBuffer(PKT_INSTRUCTION) != 0x55)
         {
           // remove the first byte in the packet
-          for (uint16_t s = 0; s < rx_length - 1; s++)
-            rxpacket[s] = rxpacket[1 + s];
-          //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-          rx_length -= 1;
+          port->skipRxBuffer(1);
           continue;
         }
 
         // re-calculate the exact length of the rx packet
-        if (wait_length != DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) + PKT_LENGTH_H + 1)
+        if (wait_length != length + PKT_LENGTH_H + 1)
         {
-          wait_length = DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) + PKT_LENGTH_H + 1;
+          wait_length = length + PKT_LENGTH_H + 1;
           continue;
         }
 
-        if (rx_length < wait_length)
+        if (rx_length >= wait_length)
         {
-          // check timeout
-          if (port->isPacketTimeout() == true)
+          // take the packet out of the buffer, the following bytes are left for the next packet
+          port->popRxBuffer(rxpacket, wait_length);
+
+          // verify CRC16
+          uint16_t crc = DXL_MAKEWORD(rxpacket[wait_length-2], rxpacket[wait_length-1]);
+          if (updateCRC(0, rxpacket, wait_length - 2) == crc)
           {
-            if (rx_length == 0)
-            {
-              result = COMM_RX_TIMEOUT;
-            }
-            else
-            {
-              result = COMM_RX_CORRUPT;
-            }
-            break;
+            result = COMM_SUCCESS;
           }
           else
           {
-            continue;
+            result = COMM_RX_CORRUPT;
           }
+          break;
         }
 
-        // verify CRC16
-        uint16_t crc = DXL_MAKEWORD(rxpacket[wait_length-2], rxpacket[wait_length-1]);
-        if (updateCRC(0, rxpacket, wait_length - 2) == crc)
-        {
-          result = COMM_SUCCESS;
-        }
-        else
+        // check timeout
+        if (port->isPacketTimeout() == true)
         {
+          port->addResponseTimeout();
           result = COMM_RX_CORRUPT;
+          break;
         }
-        break;
       }
       else
       {
         // remove unnecessary packets
-        for (uint16_t s = 0; s < rx_length - idx; s++)
-          rxpacket[s] = rxpacket[idx + s];
-        //memcpy(&rxpacket[0], &rxpacket[idx], rx_length - idx);
-        rx_length -= idx;
+        port->skipRxBuffer(idx);
+        continue;
       }
     }
     else
@@ -394,6 +710,7 @@ int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
       // check timeout
       if (port->isPacketTimeout() == true)
       {
+        port->addResponseTimeout();
         if (rx_length == 0)
         {
           result = COMM_RX_TIMEOUT;
@@ -405,13 +722,16 @@ int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
         break;
       }
     }
-#if defined(__linux__) || defined(__APPLE__)
-    usleep(0);
-#elif defined(_WIN32) || defined(_WIN64)
-    Sleep(0);
-#endif
+    // no more bytes come from a port which has failed
+    if (port->isPortError() == true)
+    {
+      result = COMM_RX_FAIL;
+      break;
+    }
+
+    // the rest of the packet is taken by the next call
+    break;
   }
-  port->is_using_ = false;
 
   if (result == COMM_SUCCESS)
     removeStuffing(rxpacket);
@@ -419,6 +739,26 @@ int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
   return result;
 }
 
+int Protocol2PacketHandler::pollRxPacket(PortHandler *port, uint8_t *rxpacket)
+{
+  int result = pollStatusPacket(port, rxpacket);
+
+  // the port stays in use until the packet is complete or timed out
+  port->endStatusPacket(result);
+
+  return result;
+}
+
+int Protocol2PacketHandler::rxPacket(PortHandler *port, uint8_t *rxpacket)
+{
+  int result;
+
+  while ((result = pollRxPacket(port, rxpacket)) == COMM_RX_WAITING)
+    port->waitForBytes();
+
+  return result;
+}
+
 // NOT for BulkRead / SyncRead instruction
 int Protocol2PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uint8_t *rxpacket, uint8_t *error)
 {
@@ -430,38 +770,42 @@ int Protocol2PacketHandler::txRxPacket(PortHandler *port, uint8_t *txpacket, uin
     return result;
 
   // (Instruction == BulkRead or SyncRead) == this function is not available.
-  if (txpacket[PKT_INSTRUCTION] == INST_BULK_READ || txpacket[PKT_INSTRUCTION] == INST_SYNC_READ)
+  if (txpacket[PKT_INSTRUCTION] == INST_BULK_READ || txpacket[PKT_INSTRUCTION] == INST_SYNC_READ ||
+      txpacket[PKT_INSTRUCTION] == INST_FAST_SYNC_READ || txpacket[PKT_INSTRUCTION] == INST_FAST_BULK_READ)
     result = COMM_NOT_AVAILABLE;
 
   // (ID == Broadcast ID) == no need to wait for status packet or not available.
   // (Instruction == action) == no need to wait for status packet
   if (txpacket[PKT_ID] == BROADCAST_ID || txpacket[PKT_INSTRUCTION] == INST_ACTION)
   {
-    port->is_using_ = false;
+    port->clearUsing();
     return result;
   }
 
   // set packet timeout
   if (txpacket[PKT_INSTRUCTION] == INST_READ)
   {
-    port->setPacketTimeout((uint16_t)(DXL_MAKEWORD(txpacket[PKT_PARAMETER0+2], txpacket[PKT_PARAMETER0+3]) + 11));
+    port->setResponseTimeout(txpacket[PKT_ID], txpacket[PKT_INSTRUCTION], (uint16_t)(DXL_MAKEWORD(txpacket[PKT_PARAMETER0+2], txpacket[PKT_PARAMETER0+3]) + 11));
   }
   else
   {
-    port->setPacketTimeout((uint16_t)11);
+    port->setResponseTimeout(txpacket[PKT_ID], txpacket[PKT_INSTRUCTION], (uint16_t)11);
     // HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST ERROR CRC16_L CRC16_H
   }
 
-  // rx packet
+  // rx packet, the port is kept over the packets of the other IDs
   do {
-    result = rxPacket(port, rxpacket);
+    while ((result = pollStatusPacket(port, rxpacket)) == COMM_RX_WAITING)
+      port->waitForBytes();
   } while (result == COMM_SUCCESS && txpacket[PKT_ID] != rxpacket[PKT_ID]);
 
   if (result == COMM_SUCCESS && txpacket[PKT_ID] == rxpacket[PKT_ID])
   {
+    port->addResponseTime(rxpacket[PKT_ID], (uint16_t)(DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) + 7));
     if (error != 0)
       *error = (uint8_t)rxpacket[PKT_ERROR];
   }
+  port->endStatusPacket(result);
 
   return result;
 }
@@ -493,7 +837,35 @@ int Protocol2PacketHandler::ping(PortHandler *port, uint8_t id, uint16_t *model_
   return result;
 }
 
+int Protocol2PacketHandler::pingTx(PortHandler *port, uint8_t id)
+{
+  int result                 = COMM_TX_FAIL;
+
+  uint8_t txpacket[10]        = {0};
+
+  if (id >= BROADCAST_ID)
+    return COMM_NOT_AVAILABLE;
+
+  txpacket[PKT_ID]            = id;
+  txpacket[PKT_LENGTH_L]      = 3;
+  txpacket[PKT_LENGTH_H]      = 0;
+  txpacket[PKT_INSTRUCTION]   = INST_PING;
+
+  result = txPacket(port, txpacket);
+
+  // set packet timeout : the status packet has the model number and the firmware version
+  if (result == COMM_SUCCESS)
+    port->setResponseTimeout(id, INST_PING, (uint16_t)14);
+
+  return result;
+}
+
 int Protocol2PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t> &id_list)
+{
+  return broadcastPing(port, id_list, 0.0, 0);
+}
+
+int Protocol2PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t> &id_list, double idle_time, int expected_count)
 {
   const int STATUS_LENGTH     = 14;
   int result                  = COMM_TX_FAIL;
@@ -502,6 +874,7 @@ int Protocol2PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t
 
   uint16_t rx_length          = 0;
   uint16_t wait_length        = STATUS_LENGTH * MAX_ID;
+  uint16_t offset             = 0;   // start of the bytes not parsed yet
 
   uint8_t txpacket[10]        = {0};
   uint8_t rxpacket[STATUS_LENGTH * MAX_ID] = {0};
@@ -514,78 +887,82 @@ int Protocol2PacketHandler::broadcastPing(PortHandler *port, std::vector<uint8_t
   txpacket[PKT_INSTRUCTION]   = INST_PING;
 
   result = txPacket(port, txpacket);
-  if (result != COMM_SUCCESS)
-  {
-    port->is_using_ = false;
+  if (result != COMM_SUCCESS)   // txPacket() has released the port, or another thread has it
     return result;
-  }
 
-  // set rx timeout
+  // set rx timeout : the time for all IDs, or the idle time which starts again whenever bytes come
   //port->setPacketTimeout((uint16_t)(wait_length * 30));
-  port->setPacketTimeout(((double)wait_length * tx_time_per_byte) + (3.0 * (double)MAX_ID) + 16.0);
+  if (idle_time > 0.0)
+    port->setPacketTimeout(idle_time);
+  else
+    port->setPacketTimeout(((double)wait_length * tx_time_per_byte) + (3.0 * (double)MAX_ID) + 16.0);
 
   while(1)
   {
-    rx_length += port->readPort(&rxpacket[rx_length], wait_length - rx_length);
-    if (port->isPacketTimeout() == true)// || rx_length >= wait_length)
-      break;
-  }
+    port->fillRxBuffer();
+    uint16_t length = port->popRxBuffer(&rxpacket[rx_length], wait_length - rx_length);
+    if (length > 0)
+    {
+      rx_length += length;
+      if (idle_time > 0.0)
+        port->setPacketTimeout(idle_time);
 
-  port->is_using_ = false;
+      // parse the status packets received so far
+      while (rx_length - offset >= STATUS_LENGTH)
+      {
+        // find packet header
+        uint16_t idx = offset + findHeader(&rxpacket[offset], rx_length - offset);
 
-  if (rx_length == 0)
-    return COMM_RX_TIMEOUT;
+        if (idx == rx_length)   // not found, the last 2 bytes might be the beginning of the header
+        {
+          offset = rx_length - 2;
+        }
+        else if (idx == offset)   // found at the beginning of the packet
+        {
+          uint8_t *packet = &rxpacket[offset];
 
-  while(1)
-  {
-    if (rx_length < STATUS_LENGTH)
-      return COMM_RX_CORRUPT;
+          // verify CRC16
+          uint16_t crc = DXL_MAKEWORD(packet[STATUS_LENGTH-2], packet[STATUS_LENGTH-1]);
 
-    uint16_t idx = 0;
+          if (updateCRC(0, packet, STATUS_LENGTH - 2) == crc)
+          {
+            result = COMM_SUCCESS;
 
-    // find packet header
-    for (idx = 0; idx < (rx_length - 2); idx++)
-    {
-      if (rxpacket[idx] == 0xFF && rxpacket[idx+1] == 0xFF && rxpacket[idx+2] == 0xFD)
-        break;
-    }
+            id_list.push_back(packet[PKT_ID]);
 
-    if (idx == 0)   // found at the beginning of the packet
-    {
-      // verify CRC16
-      uint16_t crc = DXL_MAKEWORD(rxpacket[STATUS_LENGTH-2], rxpacket[STATUS_LENGTH-1]);
+            offset += STATUS_LENGTH;
+          }
+          else
+          {
+            result = COMM_RX_CORRUPT;
 
-      if (updateCRC(0, rxpacket, STATUS_LENGTH - 2) == crc)
-      {
-        result = COMM_SUCCESS;
+            // remove header (0xFF 0xFF 0xFD)
+            offset += 3;
+          }
+        }
+        else
+        {
+          // remove unnecessary packets
+          offset = idx;
+        }
+      }
+    }
 
-        id_list.push_back(rxpacket[PKT_ID]);
+    if (expected_count > 0 && (int)id_list.size() >= expected_count)
+      break;
+    if (rx_length >= wait_length || port->isPacketTimeout() == true || port->isPortError() == true)
+      break;
+    port->waitForBytes();
+  }
 
-        for (uint16_t s = 0; s < rx_length - STATUS_LENGTH; s++)
-          rxpacket[s] = rxpacket[STATUS_LENGTH + s];
-        rx_length -= STATUS_LENGTH;
+  bool is_port_error = port->isPortError();
+  port->clearUsing();
 
-        if (rx_length == 0)
-          return result;
-      }
-      else
-      {
-        result = COMM_RX_CORRUPT;
+  if (rx_length == 0)
+    return (is_port_error == true) ? COMM_RX_FAIL : COMM_RX_TIMEOUT;
 
-        // remove header (0xFF 0xFF 0xFD)
-        for (uint16_t s = 0; s < rx_length - 3; s++)
-          rxpacket[s] = rxpacket[3 + s];
-        rx_length -= 3;
-      }
-    }
-    else
-    {
-      // remove unnecessary packets
-      for (uint16_t s = 0; s < rx_length - idx; s++)
-        rxpacket[s] = rxpacket[idx + s];
-      rx_length -= idx;
-    }
-  }
+  if (offset != rx_length)   // bytes left which are not a status packet
+    return COMM_RX_CORRUPT;
 
   return result;
 }
@@ -669,26 +1046,23 @@ int Protocol2PacketHandler::readTx(PortHandler *port, uint8_t id, uint16_t addre
 
   // set packet timeout
   if (result == COMM_SUCCESS)
-    port->setPacketTimeout((uint16_t)(length + 11));
+    port->setResponseTimeout(id, INST_READ, (uint16_t)(length + 11));
 
   return result;
 }
 
-int Protocol2PacketHandler::readRx(PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error)
+int Protocol2PacketHandler::pollReadRx(PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error)
 {
   int result                  = COMM_TX_FAIL;
-  uint8_t *rxpacket           = (uint8_t *)malloc(RXPACKET_MAX_LEN);
-  //(length + 11 + (length/3));  // (length/3): consider stuffing
-  
-  if (rxpacket == NULL)
-    return result;
-  
+  uint8_t *rxpacket           = port->getRxPacketBuffer();
+
   do {
-    result = rxPacket(port, rxpacket);
+    result = pollStatusPacket(port, rxpacket);
   } while (result == COMM_SUCCESS && rxpacket[PKT_ID] != id);
 
   if (result == COMM_SUCCESS && rxpacket[PKT_ID] == id)
   {
+    port->addResponseTime(id, (uint16_t)(length + 11));
     if (error != 0)
       *error = (uint8_t)rxpacket[PKT_ERROR];
 
@@ -699,52 +1073,31 @@ int Protocol2PacketHandler::readRx(PortHandler *port, uint8_t id, uint16_t lengt
     //memcpy(data, &rxpacket[PKT_PARAMETER0+1], length);
   }
 
-  free(rxpacket);
-  //delete[] rxpacket;
+  // the buffer of the port is given to another thread only after the data is taken
+  port->endStatusPacket(result);
+
   return result;
 }
 
-int Protocol2PacketHandler::readTxRx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error)
+int Protocol2PacketHandler::readRx(PortHandler *port, uint8_t id, uint16_t length, uint8_t *data, uint8_t *error)
 {
-  int result                  = COMM_TX_FAIL;
+  int result;
 
-  uint8_t txpacket[14]        = {0};
-  uint8_t *rxpacket           = (uint8_t *)malloc(RXPACKET_MAX_LEN);
-  //(length + 11 + (length/3));  // (length/3): consider stuffing
+  while ((result = pollReadRx(port, id, length, data, error)) == COMM_RX_WAITING)
+    port->waitForBytes();
 
-  if (rxpacket == NULL)
-    return result;
-  
-  if (id >= BROADCAST_ID)
-  {
-    free(rxpacket);
-    return COMM_NOT_AVAILABLE;
-  }
+  return result;
+}
 
-  txpacket[PKT_ID]            = id;
-  txpacket[PKT_LENGTH_L]      = 7;
-  txpacket[PKT_LENGTH_H]      = 0;
-  txpacket[PKT_INSTRUCTION]   = INST_READ;
-  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
-  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
-  txpacket[PKT_PARAMETER0+2]  = (uint8_t)DXL_LOBYTE(length);
-  txpacket[PKT_PARAMETER0+3]  = (uint8_t)DXL_HIBYTE(length);
+int Protocol2PacketHandler::readTxRx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data, uint8_t *error)
+{
+  int result                  = COMM_TX_FAIL;
 
-  result = txRxPacket(port, txpacket, rxpacket, error);
+  // the data is taken out of the buffer of the port by readRx() before the port is released
+  result = readTx(port, id, address, length);
   if (result == COMM_SUCCESS)
-  {
-    if (error != 0)
-      *error = (uint8_t)rxpacket[PKT_ERROR];
-
-    for (uint16_t s = 0; s < length; s++)
-    {
-      data[s] = rxpacket[PKT_PARAMETER0 + 1 + s];
-    }
-    //memcpy(data, &rxpacket[PKT_PARAMETER0+1], length);
-  }
+    result = readRx(port, id, length, data, error);
 
-  free(rxpacket);
-  //delete[] rxpacket;
   return result;
 }
 
@@ -816,10 +1169,10 @@ int Protocol2PacketHandler::writeTxOnly(PortHandler *port, uint8_t id, uint16_t
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length + 12 + (length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   
-  if (txpacket == NULL)
-    return result;
+  if (length + 12 + (length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
 
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
@@ -833,10 +1186,42 @@ int Protocol2PacketHandler::writeTxOnly(PortHandler *port, uint8_t id, uint16_t
   //memcpy(&txpacket[PKT_PARAMETER0+2], data, length);
 
   result = txPacket(port, txpacket);
-  port->is_using_ = false;
+  if (result == COMM_SUCCESS)   // on failure txPacket() has released the port, or another thread has it
+    port->clearUsing();
+
+  return result;
+}
+
+int Protocol2PacketHandler::writeTx(PortHandler *port, uint8_t id, uint16_t address, uint16_t length, uint8_t *data)
+{
+  int result                  = COMM_TX_FAIL;
+
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
+
+  if (id >= BROADCAST_ID)
+    return COMM_NOT_AVAILABLE;
+
+  if (length + 12 + (length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
+
+  txpacket[PKT_ID]            = id;
+  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
+  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(length+5);
+  txpacket[PKT_INSTRUCTION]   = INST_WRITE;
+  txpacket[PKT_PARAMETER0+0]  = (uint8_t)DXL_LOBYTE(address);
+  txpacket[PKT_PARAMETER0+1]  = (uint8_t)DXL_HIBYTE(address);
+
+  for (uint16_t s = 0; s < length; s++)
+    txpacket[PKT_PARAMETER0+2+s] = data[s];
+  //memcpy(&txpacket[PKT_PARAMETER0+2], data, length);
+
+  result = txPacket(port, txpacket);
+
+  // set packet timeout
+  if (result == COMM_SUCCESS)
+    port->setResponseTimeout(id, INST_WRITE, (uint16_t)11);
+    // HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST ERROR CRC16_L CRC16_H
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -844,11 +1229,11 @@ int Protocol2PacketHandler::writeTxRx(PortHandler *port, uint8_t id, uint16_t ad
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length + 12 + (length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   uint8_t rxpacket[11]        = {0};
 
-  if (txpacket == NULL)
-    return result;
+  if (length + 12 + (length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
   
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
@@ -863,8 +1248,6 @@ int Protocol2PacketHandler::writeTxRx(PortHandler *port, uint8_t id, uint16_t ad
 
   result = txRxPacket(port, txpacket, rxpacket, error);
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -905,10 +1288,10 @@ int Protocol2PacketHandler::regWriteTxOnly(PortHandler *port, uint8_t id, uint16
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length + 12 + (length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
 
-  if (txpacket == NULL)
-    return result;
+  if (length + 12 + (length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
   
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
@@ -922,10 +1305,9 @@ int Protocol2PacketHandler::regWriteTxOnly(PortHandler *port, uint8_t id, uint16
   //memcpy(&txpacket[PKT_PARAMETER0+2], data, length);
 
   result = txPacket(port, txpacket);
-  port->is_using_ = false;
+  if (result == COMM_SUCCESS)   // on failure txPacket() has released the port, or another thread has it
+    port->clearUsing();
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -933,11 +1315,11 @@ int Protocol2PacketHandler::regWriteTxRx(PortHandler *port, uint8_t id, uint16_t
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(length + 12 + (length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   uint8_t rxpacket[11]        = {0};
 
-  if (txpacket == NULL)
-    return result;
+  if (length + 12 + (length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
   
   txpacket[PKT_ID]            = id;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(length+5);
@@ -952,8 +1334,6 @@ int Protocol2PacketHandler::regWriteTxRx(PortHandler *port, uint8_t id, uint16_t
 
   result = txRxPacket(port, txpacket, rxpacket, error);
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -961,11 +1341,11 @@ int Protocol2PacketHandler::syncReadTx(PortHandler *port, uint16_t start_address
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 14 + (param_length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   // 14: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
 
-  if (txpacket == NULL)
-    return result;
+  if (param_length + 14 + (param_length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
   
   txpacket[PKT_ID]            = BROADCAST_ID;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
@@ -982,9 +1362,78 @@ int Protocol2PacketHandler::syncReadTx(PortHandler *port, uint16_t start_address
 
   result = txPacket(port, txpacket);
   if (result == COMM_SUCCESS)
-    port->setPacketTimeout((uint16_t)((11 + data_length) * param_length));
+  {
+    port->setStatusPacketCount(param_length);
+    port->setResponseTimeout(param[0], INST_SYNC_READ, (uint16_t)((11 + data_length) * param_length));
+  }
+
+  return result;
+}
+
+int Protocol2PacketHandler::fastSyncReadTx(PortHandler *port, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  int result                  = COMM_TX_FAIL;
+
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
+  // 14: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
+
+  if (param_length + 14 + (param_length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
+
+  txpacket[PKT_ID]            = BROADCAST_ID;
+  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
+  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
+  txpacket[PKT_INSTRUCTION]   = INST_FAST_SYNC_READ;
+  txpacket[PKT_PARAMETER0+0]  = DXL_LOBYTE(start_address);
+  txpacket[PKT_PARAMETER0+1]  = DXL_HIBYTE(start_address);
+  txpacket[PKT_PARAMETER0+2]  = DXL_LOBYTE(data_length);
+  txpacket[PKT_PARAMETER0+3]  = DXL_HIBYTE(data_length);
+
+  for (uint16_t s = 0; s < param_length; s++)
+    txpacket[PKT_PARAMETER0+4+s] = param[s];
+
+  result = txPacket(port, txpacket);
+  if (result == COMM_SUCCESS)
+    port->setResponseTimeout(param[0], INST_FAST_SYNC_READ, (uint16_t)(8 + (4 + data_length) * param_length));
+    // 8: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST, 4: ERROR ID CRC16_L CRC16_H
+
+  return result;
+}
+
+int Protocol2PacketHandler::pollFastReadRx(PortHandler *port, uint16_t length, uint8_t *param)
+{
+  int result                  = COMM_TX_FAIL;
+  uint8_t *rxpacket           = port->getRxPacketBuffer();
+
+  do {
+    result = pollStatusPacket(port, rxpacket);
+  } while (result == COMM_SUCCESS && rxpacket[PKT_ID] != BROADCAST_ID);
+
+  // 3: INST CRC16_L CRC16_H
+  if (result == COMM_SUCCESS && DXL_MAKEWORD(rxpacket[PKT_LENGTH_L], rxpacket[PKT_LENGTH_H]) != length + 3)
+    result = COMM_RX_CORRUPT;
+
+  if (result == COMM_SUCCESS)
+  {
+    port->addResponseTime(rxpacket[PKT_PARAMETER0+1], (uint16_t)(length + 10));  // ID of the first Dynamixel
+
+    for (uint16_t s = 0; s < length; s++)
+      param[s] = rxpacket[PKT_PARAMETER0 + s];
+  }
+
+  // the buffer of the port is given to another thread only after the data is taken
+  port->endStatusPacket(result);
+
+  return result;
+}
+
+int Protocol2PacketHandler::fastReadRx(PortHandler *port, uint16_t length, uint8_t *param)
+{
+  int result;
+
+  while ((result = pollFastReadRx(port, length, param)) == COMM_RX_WAITING)
+    port->waitForBytes();
 
-  free(txpacket);
   return result;
 }
 
@@ -992,11 +1441,11 @@ int Protocol2PacketHandler::syncWriteTxOnly(PortHandler *port, uint16_t start_ad
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 14 + (param_length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   // 14: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
 
-  if (txpacket == NULL)
-    return result;
+  if (param_length + 14 + (param_length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
   
   txpacket[PKT_ID]            = BROADCAST_ID;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
@@ -1013,20 +1462,100 @@ int Protocol2PacketHandler::syncWriteTxOnly(PortHandler *port, uint16_t start_ad
 
   result = txRxPacket(port, txpacket, 0, 0);
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
+uint16_t Protocol2PacketHandler::makeSyncWritePacket(uint8_t *txpacket, uint16_t start_address, uint16_t data_length, uint8_t *param, uint16_t param_length)
+{
+  uint16_t total_packet_length = param_length + 14;
+  // 14: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
+
+  if (total_packet_length > TXPACKET_MAX_LEN)
+    return 0;
+
+  txpacket[PKT_HEADER0]       = 0xFF;
+  txpacket[PKT_HEADER1]       = 0xFF;
+  txpacket[PKT_HEADER2]       = 0xFD;
+  txpacket[PKT_RESERVED]      = 0x00;
+  txpacket[PKT_ID]            = BROADCAST_ID;
+  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
+  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(param_length + 7); // 7: INST START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H CRC16_L CRC16_H
+  txpacket[PKT_INSTRUCTION]   = INST_SYNC_WRITE;
+  txpacket[PKT_PARAMETER0+0]  = DXL_LOBYTE(start_address);
+  txpacket[PKT_PARAMETER0+1]  = DXL_HIBYTE(start_address);
+  txpacket[PKT_PARAMETER0+2]  = DXL_LOBYTE(data_length);
+  txpacket[PKT_PARAMETER0+3]  = DXL_HIBYTE(data_length);
+
+  for (uint16_t s = 0; s < param_length; s++)
+    txpacket[PKT_PARAMETER0+4+s] = param[s];
+
+  // the packet is kept as it is, so it should need no byte stuffing
+  if (findHeader(&txpacket[PKT_PARAMETER0], total_packet_length - 2 - PKT_PARAMETER0) != total_packet_length - 2 - PKT_PARAMETER0)
+    return 0;
+
+  uint16_t crc = updateCRC(0, txpacket, total_packet_length - 2);    // 2: CRC16
+  txpacket[total_packet_length - 2] = DXL_LOBYTE(crc);
+  txpacket[total_packet_length - 1] = DXL_HIBYTE(crc);
+
+  return total_packet_length;
+}
+
+bool Protocol2PacketHandler::updateSyncWritePacket(uint8_t *txpacket, uint16_t param_index, uint8_t *data, uint16_t length)
+{
+  uint16_t total_packet_length = DXL_MAKEWORD(txpacket[PKT_LENGTH_L], txpacket[PKT_LENGTH_H]) + 7;
+  uint16_t index               = PKT_PARAMETER0 + 4 + param_index;  // 4: START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H
+
+  // CRC16 of the packet which has only the changed bits
+  uint16_t crc = 0;
+  for (uint16_t s = 0; s < length; s++)
+  {
+    uint8_t diff = txpacket[index + s] ^ data[s];
+    crc = updateCRC(crc, &diff, 1);
+    txpacket[index + s] = data[s];
+  }
+
+  // byte stuffing might be needed around the data
+  uint16_t start = (index >= PKT_PARAMETER0 + 2) ? index - 2 : PKT_PARAMETER0;
+  uint16_t end   = (index + length + 2 < total_packet_length - 2) ? index + length + 2 : total_packet_length - 2;
+  if (findHeader(&txpacket[start], end - start) != end - start)
+    return false;
+
+  crc = shiftCRC(crc, total_packet_length - 2 - (index + length));
+  crc ^= DXL_MAKEWORD(txpacket[total_packet_length - 2], txpacket[total_packet_length - 1]);
+  txpacket[total_packet_length - 2] = DXL_LOBYTE(crc);
+  txpacket[total_packet_length - 1] = DXL_HIBYTE(crc);
+
+  return true;
+}
+
+int Protocol2PacketHandler::txSyncWritePacket(PortHandler *port, uint8_t *txpacket)
+{
+  uint16_t total_packet_length   = DXL_MAKEWORD(txpacket[PKT_LENGTH_L], txpacket[PKT_LENGTH_H]) + 7;
+  uint16_t written_packet_length = 0;
+
+  if (port->setUsing() == false)
+    return COMM_PORT_BUSY;
+
+  // tx packet
+  port->clearPort();
+  written_packet_length = port->writePort(txpacket, total_packet_length);
+  port->clearUsing();
+
+  if (total_packet_length != written_packet_length)
+    return COMM_TX_FAIL;
+
+  return COMM_SUCCESS;
+}
+
 int Protocol2PacketHandler::bulkReadTx(PortHandler *port, uint8_t *param, uint16_t param_length)
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 10 + (param_length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   // 10: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST CRC16_L CRC16_H
 
-  if (txpacket == NULL)
-    return result;
+  if (param_length + 10 + (param_length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
   
   txpacket[PKT_ID]            = BROADCAST_ID;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
@@ -1043,11 +1572,40 @@ int Protocol2PacketHandler::bulkReadTx(PortHandler *port, uint8_t *param, uint16
     int wait_length = 0;
     for (uint16_t i = 0; i < param_length; i += 5)
       wait_length += DXL_MAKEWORD(param[i+3], param[i+4]) + 10;
-    port->setPacketTimeout((uint16_t)wait_length);
+    port->setStatusPacketCount(param_length / 5);
+    port->setResponseTimeout(param[0], INST_BULK_READ, (uint16_t)wait_length);
+  }
+
+  return result;
+}
+
+int Protocol2PacketHandler::fastBulkReadTx(PortHandler *port, uint8_t *param, uint16_t param_length)
+{
+  int result                  = COMM_TX_FAIL;
+
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
+  // 10: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST CRC16_L CRC16_H
+
+  if (param_length + 10 + (param_length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
+
+  txpacket[PKT_ID]            = BROADCAST_ID;
+  txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
+  txpacket[PKT_LENGTH_H]      = DXL_HIBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
+  txpacket[PKT_INSTRUCTION]   = INST_FAST_BULK_READ;
+
+  for (uint16_t s = 0; s < param_length; s++)
+    txpacket[PKT_PARAMETER0+s] = param[s];
+
+  result = txPacket(port, txpacket);
+  if (result == COMM_SUCCESS)
+  {
+    int wait_length = 8;  // HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST
+    for (uint16_t i = 0; i < param_length; i += 5)
+      wait_length += DXL_MAKEWORD(param[i+3], param[i+4]) + 4;  // 4: ERROR ID CRC16_L CRC16_H
+    port->setResponseTimeout(param[0], INST_FAST_BULK_READ, (uint16_t)wait_length);
   }
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
 
@@ -1055,11 +1613,11 @@ int Protocol2PacketHandler::bulkWriteTxOnly(PortHandler *port, uint8_t *param, u
 {
   int result                  = COMM_TX_FAIL;
 
-  uint8_t *txpacket           = (uint8_t *)malloc(param_length + 10 + (param_length / 3));
+  uint8_t txpacket[PACKET_BUFFER_SIZE];
   // 10: HEADER0 HEADER1 HEADER2 RESERVED ID LEN_L LEN_H INST CRC16_L CRC16_H
 
-  if (txpacket == NULL)
-    return result;
+  if (param_length + 10 + (param_length / 3) > PACKET_BUFFER_SIZE)
+    return COMM_TX_ERROR;
   
   txpacket[PKT_ID]            = BROADCAST_ID;
   txpacket[PKT_LENGTH_L]      = DXL_LOBYTE(param_length + 3); // 3: INST CRC16_L CRC16_H
@@ -1072,7 +1630,5 @@ int Protocol2PacketHandler::bulkWriteTxOnly(PortHandler *port, uint8_t *param, u
 
   result = txRxPacket(port, txpacket, 0, 0);
 
-  free(txpacket);
-  //delete[] txpacket;
   return result;
 }
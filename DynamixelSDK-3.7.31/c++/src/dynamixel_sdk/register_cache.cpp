@@ -0,0 +1,189 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include "register_cache.h"
+#elif defined(__APPLE__)
+#include "register_cache.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "register_cache.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/register_cache.h"
+#endif
+
+using namespace dynamixel;
+
+RegisterCache::RegisterCache(PortHandler *port, PacketHandler *ph)
+  : port_(port),
+    ph_(ph)
+{
+}
+
+void RegisterCache::setDeadband(uint16_t address, uint32_t deadband)
+{
+  for (unsigned int i = 0; i < deadband_list_.size(); i++)
+  {
+    if (deadband_list_[i].address == address)
+    {
+      deadband_list_[i].deadband = deadband;
+      return;
+    }
+  }
+
+  Deadband item;
+  item.address  = address;
+  item.deadband = deadband;
+  deadband_list_.push_back(item);
+}
+
+bool RegisterCache::isUnchanged(uint8_t id, uint16_t address, uint16_t length, uint32_t data)
+{
+  uint32_t value;
+  if (getValue(id, address, length, &value) == false)
+    return false;
+
+  if (value == data)
+    return true;
+
+  for (unsigned int i = 0; i < deadband_list_.size(); i++)
+  {
+    if (deadband_list_[i].address != address)
+      continue;
+
+    // the values are signed, as the goal position of the extended position control mode
+    int64_t diff;
+    if (length == 1)
+      diff = (int64_t)(int8_t)data - (int8_t)value;
+    else if (length == 2)
+      diff = (int64_t)(int16_t)data - (int16_t)value;
+    else
+      diff = (int64_t)(int32_t)data - (int32_t)value;
+
+    return (diff < 0 ? -diff : diff) <= (int64_t)deadband_list_[i].deadband;
+  }
+
+  return false;
+}
+
+void RegisterCache::remove(uint8_t id, uint16_t address, uint16_t length)
+{
+  std::vector<Register> &register_list = register_list_[id];
+
+  // every register which overlaps the written bytes
+  for (unsigned int i = 0; i < register_list.size(); )
+  {
+    if (register_list[i].address < address + length && address < register_list[i].address + register_list[i].length)
+    {
+      register_list[i] = register_list.back();
+      register_list.pop_back();
+    }
+    else
+    {
+      i++;
+    }
+  }
+}
+
+int RegisterCache::write(uint8_t id, uint16_t address, uint16_t length, uint32_t data, uint8_t *error)
+{
+  int     result    = COMM_TX_FAIL;
+  uint8_t dxl_error = 0;
+
+  if (id < BROADCAST_ID && isUnchanged(id, address, length, data) == true)
+  {
+    if (error != 0)
+      *error = 0;
+    return COMM_SUCCESS;
+  }
+
+  if (length == 1)
+    result = ph_->write1ByteTxRx(port_, id, address, (uint8_t)data, &dxl_error);
+  else if (length == 2)
+    result = ph_->write2ByteTxRx(port_, id, address, (uint16_t)data, &dxl_error);
+  else
+    result = ph_->write4ByteTxRx(port_, id, address, data, &dxl_error);
+
+  if (error != 0)
+    *error = dxl_error;
+
+  if (id == BROADCAST_ID)
+  {
+    for (int i = 0; i < BROADCAST_ID; i++)
+      remove(i, address, length);
+    return result;
+  }
+  if (id > BROADCAST_ID)
+    return result;
+
+  // the value which might not be written is not kept
+  remove(id, address, length);
+  if (result == COMM_SUCCESS && dxl_error == 0)
+  {
+    Register item;
+    item.address  = address;
+    item.length   = length;
+    item.value    = data;
+    register_list_[id].push_back(item);
+  }
+
+  return result;
+}
+
+int RegisterCache::write1ByteTxRx(uint8_t id, uint16_t address, uint8_t data, uint8_t *error)
+{
+  return write(id, address, 1, data, error);
+}
+
+int RegisterCache::write2ByteTxRx(uint8_t id, uint16_t address, uint16_t data, uint8_t *error)
+{
+  return write(id, address, 2, data, error);
+}
+
+int RegisterCache::write4ByteTxRx(uint8_t id, uint16_t address, uint32_t data, uint8_t *error)
+{
+  return write(id, address, 4, data, error);
+}
+
+bool RegisterCache::getValue(uint8_t id, uint16_t address, uint16_t length, uint32_t *data)
+{
+  if (id >= BROADCAST_ID)
+    return false;
+
+  std::vector<Register> &register_list = register_list_[id];
+  for (unsigned int i = 0; i < register_list.size(); i++)
+  {
+    if (register_list[i].address == address && register_list[i].length == length)
+    {
+      *data = register_list[i].value;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void RegisterCache::clear(uint8_t id)
+{
+  if (id < BROADCAST_ID)
+  {
+    register_list_[id].clear();
+    return;
+  }
+
+  for (int i = 0; i < BROADCAST_ID; i++)
+    register_list_[i].clear();
+}
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include "response_time_estimator.h"
+#include "packet_handler.h"
+#elif defined(__APPLE__)
+#include "response_time_estimator.h"
+#include "packet_handler.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "response_time_estimator.h"
+#include "packet_handler.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/response_time_estimator.h"
+#include "../../include/dynamixel_sdk/packet_handler.h"
+#endif
+
+#define INSTRUCTION_SLOTS   7
+#define MAX_BACKOFF         6   // the timeout grows up to 64 times, then is limited by the maximum timeout
+
+using namespace dynamixel;
+
+static int getInstructionSlot(uint8_t instruction)
+{
+  switch(instruction)
+  {
+    case INST_PING:
+      return 0;
+    case INST_READ:
+      return 1;
+    case INST_WRITE:
+      return 2;
+    case INST_REG_WRITE:
+      return 3;
+    case INST_SYNC_READ:
+      return 4;
+    case INST_BULK_READ:
+      return 5;
+    default:
+      return 6;
+  }
+}
+
+ResponseTimeEstimator::ResponseTimeEstimator(double min_timeout, double max_timeout)
+  : statistics_(256 * INSTRUCTION_SLOTS),
+    min_timeout_(min_timeout),
+    max_timeout_(max_timeout),
+    default_timeout_(-1.0)
+{
+  clear();
+}
+
+void ResponseTimeEstimator::setTimeoutLimit(double min_timeout, double max_timeout)
+{
+  min_timeout_ = min_timeout;
+  max_timeout_ = max_timeout;
+}
+
+ResponseTimeEstimator::Statistics *ResponseTimeEstimator::getStatistics(uint8_t id, uint8_t instruction)
+{
+  return &statistics_[id * INSTRUCTION_SLOTS + getInstructionSlot(instruction)];
+}
+
+void ResponseTimeEstimator::addSample(uint8_t id, uint8_t instruction, double msec)
+{
+  Statistics *stats[2] = { getStatistics(id, instruction), getStatistics(BROADCAST_ID, instruction) };
+
+  for (int i = 0; i < 2; i++)
+  {
+    Statistics *stat = stats[i];
+    if (stat->count == 0)
+    {
+      stat->mean      = msec;
+      stat->deviation = msec / 2.0;
+    }
+    else
+    {
+      double error    = msec - stat->mean;
+      stat->deviation = stat->deviation * 0.75 + (error < 0.0 ? -error : error) * 0.25;
+      stat->mean      = stat->mean * 0.875 + msec * 0.125;
+    }
+    stat->count++;
+  }
+
+  // a measured response ends the backoff of the ID
+  stats[0]->backoff = 0;
+}
+
+void ResponseTimeEstimator::addTimeout(uint8_t id, uint8_t instruction)
+{
+  Statistics *stat = getStatistics(id, instruction);
+  if (stat->backoff < MAX_BACKOFF)
+    stat->backoff++;
+}
+
+double ResponseTimeEstimator::getTimeout(uint8_t id, uint8_t instruction)
+{
+  Statistics *stat    = getStatistics(id, instruction);
+  uint8_t     backoff = stat->backoff;
+  if (stat->count == 0)   // the ID has never answered: use the statistics over all IDs
+    stat = getStatistics(BROADCAST_ID, instruction);
+  if (stat->count == 0)
+    return default_timeout_;
+
+  double timeout = stat->mean + 4.0 * stat->deviation;
+  if (timeout < min_timeout_)
+    timeout = min_timeout_;
+  timeout *= (double)(1 << backoff);
+  if (timeout > max_timeout_)
+    timeout = max_timeout_;
+  return timeout;
+}
+
+bool ResponseTimeEstimator::getStatistics(uint8_t id, uint8_t instruction, double *mean, double *deviation, uint32_t *count)
+{
+  Statistics *stat = getStatistics(id, instruction);
+
+  if (mean != 0)
+    *mean = stat->mean;
+  if (deviation != 0)
+    *deviation = stat->deviation;
+  if (count != 0)
+    *count = stat->count;
+
+  return stat->count != 0;
+}
+
+void ResponseTimeEstimator::clear()
+{
+  for (unsigned int i = 0; i < statistics_.size(); i++)
+  {
+    statistics_[i].mean       = 0.0;
+    statistics_[i].deviation  = 0.0;
+    statistics_[i].count      = 0;
+    statistics_[i].backoff    = 0;
+  }
+}
@@ -0,0 +1,178 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#if defined(__linux__)
+#include "transaction_queue.h"
+#elif defined(__APPLE__)
+#include "transaction_queue.h"
+#elif defined(_WIN32) || defined(_WIN64)
+#define WINDLLEXPORT
+#include "transaction_queue.h"
+#elif defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__)
+#include "../../include/dynamixel_sdk/transaction_queue.h"
+#endif
+
+#if !(defined(ARDUINO) || defined(__OPENCR__) || defined(__OPENCM904__))
+
+using namespace dynamixel;
+
+TransactionQueue::TransactionQueue(PortHandler *port)
+  : port_(port),
+    head_(&stub_),
+    tail_(&stub_),
+    pending_count_(0),
+    max_pending_(0),
+    is_running_(false),
+    is_sleeping_(false)
+{
+}
+
+// the intrusive queue of Dmitry Vyukov: a submitter exchanges the tail, then links the previous one to its transaction
+void TransactionQueue::push(Transaction *transaction)
+{
+  transaction->next_.store(0);
+  Transaction *prev = tail_.exchange(transaction);
+  prev->next_.store(transaction);
+}
+
+Transaction *TransactionQueue::pop()
+{
+  Transaction *head = head_;
+  Transaction *next = head->next_.load();
+
+  if (head == &stub_)
+  {
+    if (next == 0)
+      return 0;
+    head_ = next;
+    head  = next;
+    next  = next->next_.load();
+  }
+
+  if (next != 0)
+  {
+    head_ = next;
+    return head;
+  }
+
+  // the last one is taken only after the stub is put behind it, or when a submitter has not linked its transaction yet
+  if (head != tail_.load())
+    return 0;
+
+  push(&stub_);
+  next = head->next_.load();
+  if (next != 0)
+  {
+    head_ = next;
+    return head;
+  }
+
+  return 0;
+}
+
+bool TransactionQueue::isEmpty()
+{
+  return head_ == &stub_ && stub_.next_.load() == 0;
+}
+
+void TransactionQueue::process()
+{
+  while (true)
+  {
+    Transaction *transaction = pop();
+    if (transaction != 0)
+    {
+      // the transaction may finish its submitter, which may submit the next one at once
+      pending_count_--;
+      port_->lockPort();
+      transaction->run(port_);
+      port_->unlockPort();
+      continue;
+    }
+
+    if (isEmpty() == false)
+    {
+      // a submitter is between its two steps
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    is_sleeping_.store(true);
+    while (isEmpty() == true && is_running_.load() == true)
+      condition_.wait(lock);
+    is_sleeping_.store(false);
+
+    // after stop(), a submitter which counted itself before it saw the stop either links its transaction or takes back its count
+    if (is_running_.load() == false)
+    {
+      if (pending_count_.load() == 0)
+        break;
+      lock.unlock();
+      std::this_thread::yield();
+    }
+  }
+}
+
+bool TransactionQueue::start()
+{
+  if (is_running_.exchange(true) == true)
+    return false;
+
+  thread_ = std::thread(&TransactionQueue::process, this);
+  return true;
+}
+
+void TransactionQueue::stop()
+{
+  if (is_running_.exchange(false) == false)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_.notify_one();
+  }
+  thread_.join();
+}
+
+bool TransactionQueue::submit(Transaction *transaction)
+{
+  if (pending_count_++ >= max_pending_ && max_pending_ > 0)
+  {
+    pending_count_--;
+    return false;
+  }
+
+  // the count comes before the check, so stop() does not end the bus thread until the transaction is linked or refused
+  if (is_running_.load() == false)
+  {
+    pending_count_--;
+    return false;
+  }
+
+  push(transaction);
+
+  // the bus thread checks the queue after it marks itself sleeping, so one of the two sees the other
+  if (is_sleeping_.load() == true)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_.notify_one();
+  }
+
+  return true;
+}
+
+#endif
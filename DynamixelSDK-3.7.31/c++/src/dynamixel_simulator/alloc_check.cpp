@@ -0,0 +1,148 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+//
+// *********     Steady-State Allocation Check      *********
+//
+//
+// This program runs the cycle of a control loop over three Dynamixels, and counts the heap allocations
+// after the first cycles have set up the groups. The cycle uses Sync Write, Sync Read, Fast Sync Read,
+// Bulk Write, Bulk Read and the single reads and writes. malloc() is replaced, so the allocations of
+// the library and of operator new are both counted. Any allocation or failed transfer makes the program
+// return non-zero.
+//
+//   $ ./dxl_simulator -p 2.0 -n 3 -i 1 -l /tmp/ttyDXL &
+//   $ ./alloc_check /tmp/ttyDXL
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dynamixel_sdk.h"
+
+#define PROTOCOL_VERSION        2.0
+#define BAUDRATE                1000000
+#define DXL_COUNT               3           // ID 1, 2 and 3
+#define WARMUP_COUNT            10
+#define CYCLE_COUNT             200
+
+#define ADDR_TORQUE_ENABLE      64
+#define ADDR_GOAL_POSITION      116
+#define ADDR_PRESENT_POSITION   132
+
+using namespace dynamixel;
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+static bool is_counting = false;
+static long alloc_count = 0;
+
+extern "C" void *malloc(size_t size)
+{
+  if (is_counting == true)
+    alloc_count++;
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+  if (is_counting == true)
+    alloc_count++;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+  if (is_counting == true)
+    alloc_count++;
+  return __libc_realloc(ptr, size);
+}
+
+int main(int argc, char *argv[])
+{
+  const char *port_name = (argc > 1) ? argv[1] : "/tmp/ttyDXL";
+
+  PortHandler   *portHandler    = PortHandler::getPortHandler(port_name);
+  PacketHandler *packetHandler  = PacketHandler::getPacketHandler(PROTOCOL_VERSION);
+
+  if (portHandler->openPort() == false || portHandler->setBaudRate(BAUDRATE) == false)
+  {
+    printf("Failed to open the port %s!\n", port_name);
+    return 1;
+  }
+
+  GroupSyncWrite  groupSyncWrite(portHandler, packetHandler, ADDR_GOAL_POSITION, 4);
+  GroupSyncRead   groupSyncRead(portHandler, packetHandler, ADDR_PRESENT_POSITION, 4);
+  GroupSyncRead   groupFastSyncRead(portHandler, packetHandler, ADDR_PRESENT_POSITION, 4);
+  GroupBulkWrite  groupBulkWrite(portHandler, packetHandler);
+  GroupBulkRead   groupBulkRead(portHandler, packetHandler);
+
+  uint8_t param_goal_position[4] = { 0, 8, 0, 0 };
+  groupFastSyncRead.setFastRead(true);
+
+  for (int id = 1; id <= DXL_COUNT; id++)
+  {
+    packetHandler->write1ByteTxRx(portHandler, id, ADDR_TORQUE_ENABLE, 1);
+    groupSyncWrite.addParam(id, param_goal_position);
+    groupSyncRead.addParam(id);
+    groupFastSyncRead.addParam(id);
+    groupBulkWrite.addParam(id, ADDR_GOAL_POSITION, 4, param_goal_position);
+    groupBulkRead.addParam(id, ADDR_PRESENT_POSITION, 4);
+  }
+
+  printf("[Allocation] %d cycles, counted after %d cycles\n", CYCLE_COUNT, WARMUP_COUNT);
+
+  long fail_count = 0;
+  for (int cycle = 0; cycle < CYCLE_COUNT; cycle++)
+  {
+    if (cycle == WARMUP_COUNT)
+      is_counting = true;
+
+    param_goal_position[0] = (uint8_t)cycle;
+    for (int id = 1; id <= DXL_COUNT; id++)
+    {
+      groupSyncWrite.changeParam(id, param_goal_position);
+      groupBulkWrite.changeParam(id, ADDR_GOAL_POSITION, 4, param_goal_position);
+    }
+
+    uint32_t  present_position = 0;
+    uint8_t   dxl_error = 0;
+
+    if (groupSyncWrite.txPacket() != COMM_SUCCESS)
+      fail_count++;
+    if (groupSyncRead.txRxPacket() != COMM_SUCCESS)
+      fail_count++;
+    if (groupFastSyncRead.txRxPacket() != COMM_SUCCESS)
+      fail_count++;
+    if (groupBulkWrite.txPacket() != COMM_SUCCESS)
+      fail_count++;
+    if (groupBulkRead.txRxPacket() != COMM_SUCCESS)
+      fail_count++;
+    if (packetHandler->read4ByteTxRx(portHandler, 1, ADDR_PRESENT_POSITION, &present_position, &dxl_error) != COMM_SUCCESS)
+      fail_count++;
+    if (packetHandler->write4ByteTxRx(portHandler, 2, ADDR_GOAL_POSITION, 2048, &dxl_error) != COMM_SUCCESS)
+      fail_count++;
+  }
+  is_counting = false;
+
+  portHandler->closePort();
+
+  printf("[Allocation] %ld allocations, %ld transfers failed\n", alloc_count, fail_count);
+
+  return (alloc_count == 0 && fail_count == 0) ? 0 : 1;
+}
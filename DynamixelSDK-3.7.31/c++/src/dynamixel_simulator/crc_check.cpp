@@ -0,0 +1,148 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+//
+// *********     CRC16 Check and Benchmark      *********
+//
+//
+// This program checks the CRC16 of the Protocol 2.0 packets made by the SDK against the original byte-wise table,
+// and measures both. It needs no Dynamixel and no simulator, and returns non-zero when a CRC16 differs.
+//
+//   $ ./crc_check
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dynamixel_sdk.h"
+
+#define CHECK_COUNT     20000
+#define BENCH_BYTES     (64 * 1024 * 1024)
+
+using namespace dynamixel;
+
+static uint16_t crc_table[256];   // the table of the SDK before slicing-by-8, made from the polynomial 0x8005
+
+static void makeTable()
+{
+  for (int i = 0; i < 256; i++)
+  {
+    uint16_t crc = (uint16_t)(i << 8);
+    for (int b = 0; b < 8; b++)
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x8005) : (uint16_t)(crc << 1);
+    crc_table[i] = crc;
+  }
+}
+
+static uint16_t updateCRC(uint16_t crc_accum, const uint8_t *data_blk_ptr, uint16_t data_blk_size)
+{
+  for (uint16_t j = 0; j < data_blk_size; j++)
+  {
+    uint16_t i = ((uint16_t)(crc_accum >> 8) ^ data_blk_ptr[j]) & 0xFF;
+    crc_accum = (crc_accum << 8) ^ crc_table[i];
+  }
+  return crc_accum;
+}
+
+static double getTime()
+{
+  struct timespec tv;
+  clock_gettime(CLOCK_MONOTONIC, &tv);
+  return (double)tv.tv_sec * 1000.0 + (double)tv.tv_nsec * 0.001 * 0.001;
+}
+
+static bool checkPacket(uint8_t *txpacket, uint16_t length)
+{
+  return updateCRC(0, txpacket, length - 2) == DXL_MAKEWORD(txpacket[length - 2], txpacket[length - 1]);
+}
+
+// random data without 0xFF 0xFF 0xFD, which would need byte stuffing
+static void fillParam(uint8_t *param, int length)
+{
+  for (int i = 0; i < length; i++)
+  {
+    param[i] = (uint8_t)rand();
+    if (i >= 2 && param[i] == 0xFD && param[i - 1] == 0xFF && param[i - 2] == 0xFF)
+      param[i] = 0xFE;
+  }
+}
+
+int main()
+{
+  PacketHandler *packetHandler = PacketHandler::getPacketHandler(2.0);
+
+  static uint8_t param[PACKET_BUFFER_SIZE];
+  static uint8_t txpacket[PACKET_BUFFER_SIZE];
+  int bad_count = 0;
+
+  makeTable();
+  srand(1);
+
+  // whole packets : the slicing-by-8 loop and its tail
+  for (int t = 0; t < CHECK_COUNT; t++)
+  {
+    int data_length   = 1 + rand() % 8;
+    int param_length  = (1 + rand() % 100) * (1 + data_length);
+    fillParam(param, param_length);
+
+    uint16_t length = packetHandler->makeSyncWritePacket(txpacket, 116, data_length, param, param_length);
+    if (length == 0)
+      continue;
+    if (checkPacket(txpacket, length) == false)
+      bad_count++;
+
+    // a changed part of the packet : the CRC16 shifted over the following bytes
+    uint8_t data[8];
+    int slot = rand() % (param_length / (1 + data_length));
+    fillParam(data, data_length);
+    if (packetHandler->updateSyncWritePacket(txpacket, slot * (1 + data_length) + 1, data, data_length) == true &&
+        checkPacket(txpacket, length) == false)
+      bad_count++;
+  }
+  printf("[CRC16] %d packets checked, %d wrong\n", CHECK_COUNT, bad_count);
+
+  // the original table against the packets made by the SDK, which are almost all CRC16
+  int lengths[] = { 4, 64, 1000 };
+  for (int l = 0; l < 3; l++)
+  {
+    int param_length  = lengths[l];
+    int count         = BENCH_BYTES / param_length;
+    volatile uint16_t crc = 0;
+    fillParam(param, param_length);
+
+    double start = getTime();
+    for (int i = 0; i < count; i++)
+      crc = updateCRC(crc, param, param_length);
+    double table_time = getTime() - start;
+
+    start = getTime();
+    for (int i = 0; i < count; i++)
+      packetHandler->makeSyncWritePacket(txpacket, 116, 3, param, param_length);
+    double packet_time = getTime() - start;
+
+    start = getTime();
+    for (int i = 0; i < count; i++)
+      packetHandler->updateSyncWritePacket(txpacket, 1, param, 3);
+    double update_time = getTime() - start;
+
+    printf("[CRC16] %4d bytes : byte-wise table %.3f ns/byte, makeSyncWritePacket %.3f ns/byte, updateSyncWritePacket %.1f ns\n",
+           param_length, table_time * 1e6 / BENCH_BYTES, packet_time * 1e6 / BENCH_BYTES, update_time * 1e6 / count);
+  }
+
+  return (bad_count == 0) ? 0 : 1;
+}
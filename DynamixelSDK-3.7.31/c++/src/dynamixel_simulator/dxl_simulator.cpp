@@ -0,0 +1,149 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+//
+// *********     Virtual Dynamixel Bus Simulator      *********
+//
+//
+// Available Dynamixel model on this simulator : XM430-W350 (Protocol 2.0), MX-28 (Protocol 1.0)
+// This simulator opens a pseudo terminal and prints its name.
+// Open the name with PortHandler instead of /dev/ttyUSB0 to run the examples without any Dynamixel.
+//
+//   $ ./dxl_simulator -n 2 -b 57600 -l /tmp/ttyDXL
+//   $ ./sync_read_write             (with DEVICENAME "/tmp/ttyDXL")
+//
+
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "virtual_bus.h"
+
+static volatile bool is_running = true;
+
+static void stopSimulator(int)
+{
+  is_running = false;
+}
+
+static void usage(char *progname)
+{
+  printf("-----------------------------------------------------------------------\n");
+  printf("Usage: %s\n", progname);
+  printf(" [-h | --help]........: display this help\n");
+  printf(" [-p | --protocol]....: protocol version of the Dynamixels, 1.0 or 2.0 (default 2.0)\n");
+  printf(" [-n | --number]......: number of the Dynamixels (default 1)\n");
+  printf(" [-i | --id]..........: ID of the first Dynamixel (default 1)\n");
+  printf(" [-b | --baudrate]....: baudrate of the Dynamixels (default 57600)\n");
+  printf(" [-r | --return-delay]: return delay time in usec (default 500)\n");
+  printf(" [-l | --link]........: symbolic link to create for the port (ex. /tmp/ttyDXL)\n");
+  printf("-----------------------------------------------------------------------\n");
+}
+
+int main(int argc, char *argv[])
+{
+  float protocol_version  = 2.0;
+  int   dxl_count         = 1;
+  int   first_id          = 1;
+  int   baudrate          = 57600;
+  int   return_delay      = 500;
+  char *link_name         = 0;
+
+  static struct option long_options[] =
+  {
+    { "help",         no_argument,       0, 'h' },
+    { "protocol",     required_argument, 0, 'p' },
+    { "number",       required_argument, 0, 'n' },
+    { "id",           required_argument, 0, 'i' },
+    { "baudrate",     required_argument, 0, 'b' },
+    { "return-delay", required_argument, 0, 'r' },
+    { "link",         required_argument, 0, 'l' },
+    { 0, 0, 0, 0 }
+  };
+
+  while (1)
+  {
+    int c = getopt_long(argc, argv, "hp:n:i:b:r:l:", long_options, NULL);
+    if (c == -1)
+      break;
+
+    switch (c)
+    {
+      case 'p':
+        protocol_version = (float)atof(optarg);
+        break;
+      case 'n':
+        dxl_count = atoi(optarg);
+        break;
+      case 'i':
+        first_id = atoi(optarg);
+        break;
+      case 'b':
+        baudrate = atoi(optarg);
+        break;
+      case 'r':
+        return_delay = atoi(optarg);
+        break;
+      case 'l':
+        link_name = optarg;
+        break;
+      case 'h':
+      default:
+        usage(argv[0]);
+        return 0;
+    }
+  }
+
+  if ((protocol_version != 1.0 && protocol_version != 2.0) || dxl_count < 1 || first_id < 0 || first_id + dxl_count - 1 > 252)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  dynamixel::VirtualBus bus(protocol_version, baudrate);
+  for (int id = first_id; id < first_id + dxl_count; id++)
+    bus.addDynamixel((uint8_t)id, return_delay);
+
+  if (bus.openPort() == false)
+    return 1;
+
+  if (link_name != 0)
+  {
+    unlink(link_name);
+    if (symlink(bus.getPortName(), link_name) != 0)
+    {
+      printf("Failed to create %s!\n", link_name);
+      return 1;
+    }
+  }
+
+  signal(SIGINT, stopSimulator);
+  signal(SIGTERM, stopSimulator);
+
+  printf("%d Dynamixel(s) of Protocol %.1f (ID %d~%d) at %d bps on %s\n",
+         dxl_count, protocol_version, first_id, first_id + dxl_count - 1, baudrate, (link_name != 0) ? link_name : bus.getPortName());
+  fflush(stdout);
+
+  while (is_running)
+    bus.run(100);
+
+  if (link_name != 0)
+    unlink(link_name);
+  return 0;
+}
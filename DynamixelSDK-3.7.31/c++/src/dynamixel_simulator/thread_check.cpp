@@ -0,0 +1,353 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+//
+// *********     Shared Port Check      *********
+//
+//
+// This program shares one port between threads, in two modes.
+//
+// queue : four producers submit through one AsyncHandler, so through its TransactionQueue. One of them runs
+//         Sync Read and Bulk Read over three Dynamixels, the others write and read back one Dynamixel each,
+//         with several futures in flight and pauses which let the bus thread sleep. Every future must complete
+//         with COMM_SUCCESS and the right data. COMM_PORT_BUSY is a failure, as the queue should never return it.
+// port  : two threads call the blocking functions on the port without PortHandler::lockPort(). A thread which
+//         finds the port in use tries again, any other failure or any wrong data is a failure.
+//
+// Both modes run when no mode is given, and the program returns non-zero when any of them fails.
+//
+//   $ ./dxl_simulator -p 2.0 -n 3 -i 1 -l /tmp/ttyDXL &
+//   $ ./thread_check /tmp/ttyDXL [queue|port]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "dynamixel_sdk.h"
+
+#define PROTOCOL_VERSION        2.0
+#define BAUDRATE                1000000
+#define DXL_COUNT               3           // ID 1, 2 and 3
+#define CHECK_COUNT             500
+
+#define PRODUCER_COUNT          (1 + DXL_COUNT)   // producer 0 runs the group reads, producer n the ID n
+#define BATCH_COUNT             8                 // futures in flight of each producer
+#define FUTURE_TIMEOUT          5000              // msec
+
+#define ADDR_ID                 7
+#define ADDR_PROFILE_VELOCITY   112
+#define ADDR_GOAL_POSITION      116
+
+using namespace dynamixel;
+
+static PortHandler   *portHandler;
+static PacketHandler *packetHandler;
+static AsyncHandler  *asyncHandler;
+
+static int busy_count[PRODUCER_COUNT];
+static int fail_count[PRODUCER_COUNT];
+
+static uint32_t getGoalPosition(int id)
+{
+  return (uint32_t)(1000 + id * 100);
+}
+
+static void clearCount()
+{
+  memset(busy_count, 0, sizeof(busy_count));
+  memset(fail_count, 0, sizeof(fail_count));
+}
+
+static bool checkResult(int thread, int result)
+{
+  if (result == COMM_SUCCESS)
+    return true;
+
+  if (fail_count[thread]++ < 10)
+    printf("[Thread %d] %s\n", thread, packetHandler->getTxRxResult(result));
+  return false;
+}
+
+// a future which never completes leaves the transaction with the buffers of the producer, so the program ends at once
+static bool checkFuture(int producer, std::future<int> &future)
+{
+  if (future.wait_for(std::chrono::milliseconds(FUTURE_TIMEOUT)) != std::future_status::ready)
+  {
+    printf("[Producer %d] A transaction has not completed in %d msec!\n", producer, FUTURE_TIMEOUT);
+    fflush(stdout);
+    _Exit(1);
+  }
+
+  int result = future.get();
+  if (result == COMM_PORT_BUSY)
+    busy_count[producer]++;
+  return checkResult(producer, result);
+}
+
+static bool checkGroupSyncRead(int thread, GroupSyncRead &groupSyncRead)
+{
+  for (int id = 1; id <= DXL_COUNT; id++)
+  {
+    if (groupSyncRead.isAvailable(id, ADDR_GOAL_POSITION, 4) == false ||
+        groupSyncRead.getData(id, ADDR_GOAL_POSITION, 4) != getGoalPosition(id))
+      return checkResult(thread, COMM_RX_CORRUPT);
+  }
+  return true;
+}
+
+static bool checkGroupBulkRead(int thread, GroupBulkRead &groupBulkRead)
+{
+  if (groupBulkRead.getData(1, ADDR_GOAL_POSITION, 4) != getGoalPosition(1) ||
+      groupBulkRead.getData(2, ADDR_ID, 1) != 2 ||
+      groupBulkRead.getData(3, ADDR_GOAL_POSITION, 4) != getGoalPosition(3))
+    return checkResult(thread, COMM_RX_CORRUPT);
+  return true;
+}
+
+static void addGroupParam(GroupSyncRead &groupSyncRead, GroupBulkRead &groupBulkRead)
+{
+  for (int id = 1; id <= DXL_COUNT; id++)
+  {
+    groupSyncRead.addParam(id);
+    if (id == 2)
+      groupBulkRead.addParam(id, ADDR_ID, 1);
+    else
+      groupBulkRead.addParam(id, ADDR_GOAL_POSITION, 4);
+  }
+}
+
+static void pause(int i, int producer)
+{
+  // now and then all producers wait, so the bus thread sleeps and is woken by the next submit
+  if (i % 4 == 0)
+    std::this_thread::sleep_for(std::chrono::microseconds(100 * producer + 50));
+}
+
+// queue mode : Sync Read and Bulk Read of the goal positions, which stay as they are, two of each in flight
+static void queueGroupThread()
+{
+  GroupSyncRead groupSyncRead0(portHandler, packetHandler, ADDR_GOAL_POSITION, 4);
+  GroupSyncRead groupSyncRead1(portHandler, packetHandler, ADDR_GOAL_POSITION, 4);
+  GroupBulkRead groupBulkRead0(portHandler, packetHandler);
+  GroupBulkRead groupBulkRead1(portHandler, packetHandler);
+
+  GroupSyncRead *groupSyncRead[2] = { &groupSyncRead0, &groupSyncRead1 };
+  GroupBulkRead *groupBulkRead[2] = { &groupBulkRead0, &groupBulkRead1 };
+
+  for (int g = 0; g < 2; g++)
+    addGroupParam(*groupSyncRead[g], *groupBulkRead[g]);
+
+  for (int i = 0; i < CHECK_COUNT / 2; i++)
+  {
+    std::future<int> future[4];
+    for (int g = 0; g < 2; g++)
+    {
+      future[g * 2 + 0] = asyncHandler->txRxPacket(*groupSyncRead[g]);
+      future[g * 2 + 1] = asyncHandler->txRxPacket(*groupBulkRead[g]);
+    }
+
+    for (int g = 0; g < 2; g++)
+    {
+      if (checkFuture(0, future[g * 2 + 0]) == true)
+        checkGroupSyncRead(0, *groupSyncRead[g]);
+      if (checkFuture(0, future[g * 2 + 1]) == true)
+        checkGroupBulkRead(0, *groupBulkRead[g]);
+    }
+
+    pause(i, 0);
+  }
+}
+
+// queue mode : writes and reads back the profile velocity of one Dynamixel, which only this producer changes
+static void queueSingleThread(int id)
+{
+  for (int i = 0; i < CHECK_COUNT / BATCH_COUNT; i++)
+  {
+    std::future<int>  write_future[BATCH_COUNT];
+    std::future<int>  read_future[BATCH_COUNT];
+    std::future<int>  goal_future[BATCH_COUNT];
+    uint32_t          velocity[BATCH_COUNT];
+    uint32_t          goal_position[BATCH_COUNT];
+    uint8_t           dxl_error[BATCH_COUNT];
+
+    // the transactions of a producer run in the order submitted, so each read finds the write just before it
+    for (int b = 0; b < BATCH_COUNT; b++)
+    {
+      uint32_t value = (uint32_t)(id * 10000 + i * BATCH_COUNT + b);
+      write_future[b] = asyncHandler->write4ByteTxRx(id, ADDR_PROFILE_VELOCITY, value);
+      read_future[b]  = asyncHandler->read4ByteTxRx(id, ADDR_PROFILE_VELOCITY, &velocity[b], &dxl_error[b]);
+      goal_future[b]  = asyncHandler->read4ByteTxRx(id, ADDR_GOAL_POSITION, &goal_position[b]);
+    }
+
+    for (int b = 0; b < BATCH_COUNT; b++)
+    {
+      uint32_t value = (uint32_t)(id * 10000 + i * BATCH_COUNT + b);
+      checkFuture(id, write_future[b]);
+      if (checkFuture(id, read_future[b]) == true && (velocity[b] != value || dxl_error[b] != 0))
+        checkResult(id, COMM_RX_CORRUPT);
+      if (checkFuture(id, goal_future[b]) == true && goal_position[b] != getGoalPosition(id))
+        checkResult(id, COMM_RX_CORRUPT);
+    }
+
+    pause(i, id);
+  }
+}
+
+// port mode : Sync Read and Bulk Read of the goal positions, which stay as they are
+static void portGroupThread()
+{
+  GroupSyncRead groupSyncRead(portHandler, packetHandler, ADDR_GOAL_POSITION, 4);
+  GroupBulkRead groupBulkRead(portHandler, packetHandler);
+
+  addGroupParam(groupSyncRead, groupBulkRead);
+
+  for (int i = 0; i < CHECK_COUNT; i++)
+  {
+    int result;
+    while ((result = groupSyncRead.txRxPacket()) == COMM_PORT_BUSY)
+    {
+      busy_count[0]++;
+      std::this_thread::yield();
+    }
+    if (checkResult(0, result) == true)
+      checkGroupSyncRead(0, groupSyncRead);
+
+    while ((result = groupBulkRead.txRxPacket()) == COMM_PORT_BUSY)
+    {
+      busy_count[0]++;
+      std::this_thread::yield();
+    }
+    if (checkResult(0, result) == true)
+      checkGroupBulkRead(0, groupBulkRead);
+  }
+}
+
+// port mode : writes and reads back the profile velocity of each Dynamixel, and reads its goal position
+static void portSingleThread()
+{
+  for (int i = 0; i < CHECK_COUNT; i++)
+  {
+    int       id    = 1 + i % DXL_COUNT;
+    uint32_t  value = (uint32_t)(i + 1);
+    uint32_t  data  = 0;
+    uint8_t   dxl_error = 0;
+    int       result;
+
+    while ((result = packetHandler->write4ByteTxRx(portHandler, id, ADDR_PROFILE_VELOCITY, value, &dxl_error)) == COMM_PORT_BUSY)
+    {
+      busy_count[1]++;
+      std::this_thread::yield();
+    }
+    if (checkResult(1, result) == false)
+      continue;
+
+    while ((result = packetHandler->read4ByteTxRx(portHandler, id, ADDR_PROFILE_VELOCITY, &data, &dxl_error)) == COMM_PORT_BUSY)
+    {
+      busy_count[1]++;
+      std::this_thread::yield();
+    }
+    if (checkResult(1, result) == true && data != value)
+      checkResult(1, COMM_RX_CORRUPT);
+
+    while ((result = packetHandler->read4ByteTxRx(portHandler, id, ADDR_GOAL_POSITION, &data, &dxl_error)) == COMM_PORT_BUSY)
+    {
+      busy_count[1]++;
+      std::this_thread::yield();
+    }
+    if (checkResult(1, result) == true && data != getGoalPosition(id))
+      checkResult(1, COMM_RX_CORRUPT);
+  }
+}
+
+static bool runQueueCheck()
+{
+  clearCount();
+  asyncHandler = new AsyncHandler(portHandler, packetHandler);
+
+  std::thread producer[PRODUCER_COUNT];
+  producer[0] = std::thread(queueGroupThread);
+  for (int id = 1; id <= DXL_COUNT; id++)
+    producer[id] = std::thread(queueSingleThread, id);
+  for (int p = 0; p < PRODUCER_COUNT; p++)
+    producer[p].join();
+
+  delete asyncHandler;
+  asyncHandler = 0;
+
+  int fail_sum = 0, busy_sum = 0;
+  for (int p = 0; p < PRODUCER_COUNT; p++)
+  {
+    fail_sum += fail_count[p];
+    busy_sum += busy_count[p];
+  }
+  printf("[Transaction Queue] %d producers : %d failed, %d busy\n", PRODUCER_COUNT, fail_sum, busy_sum);
+
+  return fail_sum == 0 && busy_sum == 0;
+}
+
+static bool runPortCheck()
+{
+  clearCount();
+
+  std::thread group_thread(portGroupThread);
+  std::thread single_thread(portSingleThread);
+  group_thread.join();
+  single_thread.join();
+
+  printf("[Shared Port] group thread : %d failed, %d busy / single thread : %d failed, %d busy\n",
+         fail_count[0], busy_count[0], fail_count[1], busy_count[1]);
+
+  return fail_count[0] == 0 && fail_count[1] == 0;
+}
+
+int main(int argc, char *argv[])
+{
+  const char *port_name = (argc > 1) ? argv[1] : "/tmp/ttyDXL";
+  const char *mode      = (argc > 2) ? argv[2] : "";
+
+  portHandler   = PortHandler::getPortHandler(port_name);
+  packetHandler = PacketHandler::getPacketHandler(PROTOCOL_VERSION);
+
+  if (portHandler->openPort() == false || portHandler->setBaudRate(BAUDRATE) == false)
+  {
+    printf("Failed to open the port %s!\n", port_name);
+    return 1;
+  }
+
+  for (int id = 1; id <= DXL_COUNT; id++)
+  {
+    uint8_t dxl_error = 0;
+    if (packetHandler->write4ByteTxRx(portHandler, id, ADDR_GOAL_POSITION, getGoalPosition(id), &dxl_error) != COMM_SUCCESS || dxl_error != 0)
+    {
+      printf("Failed to set the goal position of [ID:%03d]!\n", id);
+      return 1;
+    }
+  }
+
+  bool is_passed = true;
+  if (strcmp(mode, "port") != 0)
+    is_passed = runQueueCheck() && is_passed;
+  if (strcmp(mode, "queue") != 0)
+    is_passed = runPortCheck() && is_passed;
+
+  portHandler->closePort();
+
+  return (is_passed == true) ? 0 : 1;
+}
@@ -0,0 +1,741 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include "virtual_bus.h"
+#include "packet_handler.h"
+
+#define RX_CHUNK_SIZE       4096
+#define MAX_PACKET_LENGTH   (4*1024)
+
+using namespace dynamixel;
+
+namespace
+{
+
+const struct { speed_t flag; int baudrate; } BAUDRATES[] =
+{
+  { B9600,    9600    },
+  { B19200,   19200   },
+  { B38400,   38400   },
+  { B57600,   57600   },
+  { B115200,  115200  },
+  { B230400,  230400  },
+  { B460800,  460800  },
+  { B500000,  500000  },
+  { B576000,  576000  },
+  { B921600,  921600  },
+  { B1000000, 1000000 },
+  { B1152000, 1152000 },
+  { B1500000, 1500000 },
+  { B2000000, 2000000 },
+  { B2500000, 2500000 },
+  { B3000000, 3000000 },
+  { B3500000, 3500000 },
+  { B4000000, 4000000 },
+};
+
+uint16_t updateCRC(uint16_t crc_accum, const uint8_t *data_blk_ptr, int data_blk_size)
+{
+  for (int j = 0; j < data_blk_size; j++)
+  {
+    crc_accum ^= (uint16_t)data_blk_ptr[j] << 8;
+    for (int i = 0; i < 8; i++)
+      crc_accum = (crc_accum & 0x8000) ? (uint16_t)((crc_accum << 1) ^ 0x8005) : (uint16_t)(crc_accum << 1);
+  }
+  return crc_accum;
+}
+
+bool compareID(VirtualDynamixel *a, VirtualDynamixel *b)
+{
+  return a->getID() < b->getID();
+}
+
+}
+
+VirtualBus::VirtualBus(float protocol_version, int baudrate)
+  : protocol_version_(protocol_version),
+    default_baudrate_(baudrate),
+    master_fd_(-1),
+    slave_fd_(-1),
+    bus_free_time_(0.0)
+{
+  port_name_[0] = '\0';
+}
+
+VirtualBus::~VirtualBus()
+{
+  if (master_fd_ != -1)
+    close(master_fd_);
+  if (slave_fd_ != -1)
+    close(slave_fd_);
+
+  for (unsigned int i = 0; i < dxl_list_.size(); i++)
+    delete dxl_list_[i];
+}
+
+void VirtualBus::addDynamixel(uint8_t id, int return_delay_usec)
+{
+  dxl_list_.push_back(new VirtualDynamixel(id, protocol_version_, default_baudrate_, return_delay_usec));
+}
+
+bool VirtualBus::openPort()
+{
+  // keep the slave side opened, so that the master side doesn't hang up while no PortHandler opens the port
+  if (openpty(&master_fd_, &slave_fd_, port_name_, NULL, NULL) < 0)
+  {
+    printf("[VirtualBus::openPort] openpty failed!\n");
+    return false;
+  }
+
+  struct termios tio;
+  tcgetattr(slave_fd_, &tio);
+  cfmakeraw(&tio);
+  cfsetspeed(&tio, B57600);
+  tcsetattr(slave_fd_, TCSANOW, &tio);
+
+  tcgetattr(master_fd_, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(master_fd_, TCSANOW, &tio);
+
+  return true;
+}
+
+char *VirtualBus::getPortName()
+{
+  return port_name_;
+}
+
+double VirtualBus::getCurrentTime()
+{
+  struct timespec tv;
+  clock_gettime(CLOCK_MONOTONIC, &tv);
+  return (double)tv.tv_sec + (double)tv.tv_nsec * 1e-9;
+}
+
+int VirtualBus::getPortBaudRate()
+{
+  struct termios tio;
+  if (tcgetattr(slave_fd_, &tio) == 0)
+  {
+    speed_t speed = cfgetospeed(&tio);
+    for (unsigned int i = 0; i < sizeof(BAUDRATES) / sizeof(BAUDRATES[0]); i++)
+    {
+      if (BAUDRATES[i].flag == speed)
+        return BAUDRATES[i].baudrate;
+    }
+  }
+  return default_baudrate_;
+}
+
+double VirtualBus::getByteTime()
+{
+  return 10.0 / (double)getPortBaudRate();  // 1 start bit + 8 data bits + 1 stop bit
+}
+
+VirtualDynamixel *VirtualBus::findDynamixel(uint8_t id)
+{
+  int port_baudrate = getPortBaudRate();
+
+  for (unsigned int i = 0; i < dxl_list_.size(); i++)
+  {
+    VirtualDynamixel *dxl = dxl_list_[i];
+    if (dxl->getID() != id)
+      continue;
+
+    // a Dynamixel with the different baudrate can't make out the packet
+    int diff = dxl->getBaudRate() - port_baudrate;
+    if (diff < 0)
+      diff = -diff;
+    if (diff > port_baudrate * 3 / 100)
+      return 0;
+    return dxl;
+  }
+  return 0;
+}
+
+void VirtualBus::transmit(const uint8_t *data, int length, double start_time)
+{
+  double  byte_time = getByteTime();
+  int     chunk     = (int)(100e-6 / byte_time);  // write every 100 usec at most
+  if (chunk < 1)
+    chunk = 1;
+
+  if (start_time < getCurrentTime())
+    start_time = getCurrentTime();
+
+  for (int i = 0; i < length; i += chunk)
+  {
+    int     n         = std::min(chunk, length - i);
+    double  send_time = start_time + (i + n) * byte_time;
+    struct timespec ts;
+    ts.tv_sec   = (time_t)send_time;
+    ts.tv_nsec  = (long)((send_time - (double)ts.tv_sec) * 1e9);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) { }
+
+    if (write(master_fd_, data + i, n) != n)
+      printf("[VirtualBus::transmit] write failed!\n");
+  }
+
+  bus_free_time_ = start_time + length * byte_time;
+}
+
+void VirtualBus::sendStatus(VirtualDynamixel *dxl, uint8_t error, const uint8_t *param, uint16_t param_length)
+{
+  tx_buffer_.clear();
+
+  if (protocol_version_ == 1.0)
+  {
+    // HEADER0 HEADER1 ID LENGTH ERROR PARAM... CHECKSUM
+    tx_buffer_.push_back(0xFF);
+    tx_buffer_.push_back(0xFF);
+    tx_buffer_.push_back(dxl->getID());
+    tx_buffer_.push_back((uint8_t)(param_length + 2));
+    tx_buffer_.push_back(error);
+    tx_buffer_.insert(tx_buffer_.end(), param, param + param_length);
+
+    uint8_t checksum = 0;
+    for (unsigned int i = 2; i < tx_buffer_.size(); i++)
+      checksum += tx_buffer_[i];
+    tx_buffer_.push_back(~checksum);
+  }
+  else
+  {
+    // HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST ERROR PARAM... CRC16_L CRC16_H
+    uint8_t header[] = { 0xFF, 0xFF, 0xFD, 0x00, dxl->getID(), 0, 0, INST_STATUS, error };
+    tx_buffer_.insert(tx_buffer_.end(), header, header + sizeof(header));
+
+    for (uint16_t i = 0; i < param_length; i++)
+    {
+      tx_buffer_.push_back(param[i]);
+
+      // byte stuffing
+      size_t size = tx_buffer_.size();
+      if (tx_buffer_[size - 3] == 0xFF && tx_buffer_[size - 2] == 0xFF && tx_buffer_[size - 1] == 0xFD)
+        tx_buffer_.push_back(0xFD);
+    }
+
+    uint16_t length = (uint16_t)(tx_buffer_.size() - 7 + 2);
+    tx_buffer_[5] = DXL_LOBYTE(length);
+    tx_buffer_[6] = DXL_HIBYTE(length);
+
+    uint16_t crc = updateCRC(0, tx_buffer_.data(), (int)tx_buffer_.size());
+    tx_buffer_.push_back(DXL_LOBYTE(crc));
+    tx_buffer_.push_back(DXL_HIBYTE(crc));
+  }
+
+  transmit(tx_buffer_.data(), (int)tx_buffer_.size(), bus_free_time_ + dxl->getReturnDelayTime() * 1e-6);
+}
+
+void VirtualBus::sendFastStatus(const std::vector<uint8_t> &id_list, const std::vector<uint16_t> &address_list, const std::vector<uint16_t> &length_list)
+{
+  // HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST [ERROR ID DATA... CRC16_L CRC16_H]... CRC16_L CRC16_H
+  // The first Dynamixel sends the header, and the others add their data in turn.
+  // The CRC16 of each Dynamixel covers the packet until its data, and the last one is the CRC16 of the packet.
+  uint16_t length = 1;  // INST
+  for (unsigned int i = 0; i < id_list.size(); i++)
+    length += length_list[i] + 4;
+
+  std::vector<uint8_t> packet;
+  uint8_t header[] = { 0xFF, 0xFF, 0xFD, 0x00, BROADCAST_ID, DXL_LOBYTE(length), DXL_HIBYTE(length), INST_STATUS };
+  packet.insert(packet.end(), header, header + sizeof(header));
+
+  VirtualDynamixel *first_dxl = 0;
+  std::vector<uint8_t> data;
+  unsigned int responded = 0;
+  for (; responded < id_list.size(); responded++)
+  {
+    VirtualDynamixel *dxl = findDynamixel(id_list[responded]);
+    if (dxl == 0 || isResponding(dxl, INST_FAST_SYNC_READ) == false)
+      break;  // the packet is cut here, since the following Dynamixels wait for this one
+    if (first_dxl == 0)
+      first_dxl = dxl;
+
+    data.resize(length_list[responded]);
+    uint8_t error = dxl->read(address_list[responded], length_list[responded], data.data());
+    packet.push_back(error);
+    packet.push_back(id_list[responded]);
+    packet.insert(packet.end(), data.begin(), data.end());
+
+    if (responded + 1 < id_list.size())
+    {
+      uint16_t crc = updateCRC(0, packet.data(), (int)packet.size());
+      packet.push_back(DXL_LOBYTE(crc));
+      packet.push_back(DXL_HIBYTE(crc));
+    }
+  }
+  if (first_dxl == 0)
+    return;
+
+  // byte stuffing
+  tx_buffer_.assign(packet.begin(), packet.begin() + sizeof(header));
+  for (unsigned int i = sizeof(header); i < packet.size(); i++)
+  {
+    tx_buffer_.push_back(packet[i]);
+
+    size_t size = tx_buffer_.size();
+    if (tx_buffer_[size - 3] == 0xFF && tx_buffer_[size - 2] == 0xFF && tx_buffer_[size - 1] == 0xFD)
+      tx_buffer_.push_back(0xFD);
+  }
+
+  length += (uint16_t)(tx_buffer_.size() - packet.size());
+  tx_buffer_[5] = DXL_LOBYTE(length);
+  tx_buffer_[6] = DXL_HIBYTE(length);
+
+  if (responded == id_list.size())
+  {
+    uint16_t crc = updateCRC(0, tx_buffer_.data(), (int)tx_buffer_.size());
+    tx_buffer_.push_back(DXL_LOBYTE(crc));
+    tx_buffer_.push_back(DXL_HIBYTE(crc));
+  }
+
+  transmit(tx_buffer_.data(), (int)tx_buffer_.size(), bus_free_time_ + first_dxl->getReturnDelayTime() * 1e-6);
+}
+
+bool VirtualBus::isResponding(VirtualDynamixel *dxl, uint8_t instruction)
+{
+  // Status Return Level 0 : PING only, 1 : PING and READ, 2 : all instructions
+  switch (instruction)
+  {
+    case INST_PING:
+      return true;
+    case INST_READ:
+    case INST_SYNC_READ:
+    case INST_FAST_SYNC_READ:
+    case INST_BULK_READ:
+    case INST_FAST_BULK_READ:
+      return dxl->getStatusReturnLevel() >= 1;
+    default:
+      return dxl->getStatusReturnLevel() >= 2;
+  }
+}
+
+void VirtualBus::processPacket1(uint8_t id, uint8_t instruction, const uint8_t *param, uint16_t param_length)
+{
+  std::vector<uint8_t> data;
+  VirtualDynamixel *dxl = findDynamixel(id);
+
+  if (instruction == INST_SYNC_WRITE)
+  {
+    // START_ADDR DATA_LEN [ID DATA...]...
+    if (id != BROADCAST_ID || param_length < 2)
+      return;
+    for (int i = 2; i + 1 + param[1] <= param_length; i += 1 + param[1])
+    {
+      dxl = findDynamixel(param[i]);
+      if (dxl != 0)
+        dxl->write(param[0], param[1], &param[i + 1]);
+    }
+    return;
+  }
+  if (instruction == INST_BULK_READ)
+  {
+    // 0x00 [DATA_LEN ID START_ADDR]...
+    if (id != BROADCAST_ID)
+      return;
+    for (int i = 1; i + 3 <= param_length; i += 3)
+    {
+      dxl = findDynamixel(param[i + 1]);
+      if (dxl == 0 || isResponding(dxl, instruction) == false)
+        continue;
+      data.resize(param[i]);
+      uint8_t error = dxl->read(param[i + 2], param[i], data.data());
+      sendStatus(dxl, error, data.data(), error ? 0 : param[i]);
+    }
+    return;
+  }
+
+  if (id == BROADCAST_ID)
+  {
+    for (unsigned int i = 0; i < dxl_list_.size(); i++)
+    {
+      dxl = findDynamixel(dxl_list_[i]->getID());
+      if (dxl == 0)
+        continue;
+      if (instruction == INST_WRITE && param_length >= 1)
+        dxl->write(param[0], param_length - 1, &param[1]);
+      else if (instruction == INST_REG_WRITE && param_length >= 1)
+        dxl->regWrite(param[0], param_length - 1, &param[1]);
+      else if (instruction == INST_ACTION)
+        dxl->action();
+      else if (instruction == INST_PING)   // Protocol 1.0 doesn't support broadcast ping
+        continue;
+    }
+    return;
+  }
+
+  if (dxl == 0)
+    return;
+
+  uint8_t error = 0;
+  switch (instruction)
+  {
+    case INST_PING:
+      break;
+
+    case INST_READ:
+      if (param_length != 2)
+      {
+        error = dxl->getInstructionError();
+        break;
+      }
+      data.resize(param[1]);
+      error = dxl->read(param[0], param[1], data.data());
+      if (error != 0)
+        data.clear();
+      break;
+
+    case INST_WRITE:
+      error = (param_length >= 1) ? dxl->write(param[0], param_length - 1, &param[1]) : dxl->getInstructionError();
+      break;
+
+    case INST_REG_WRITE:
+      error = (param_length >= 1) ? dxl->regWrite(param[0], param_length - 1, &param[1]) : dxl->getInstructionError();
+      break;
+
+    case INST_ACTION:
+      error = dxl->action();
+      break;
+
+    case INST_FACTORY_RESET:
+      if (isResponding(dxl, instruction))
+        sendStatus(dxl, 0, 0, 0);
+      dxl->factoryReset(0xFF);
+      return;
+
+    default:
+      error = dxl->getInstructionError();
+      break;
+  }
+
+  if (isResponding(dxl, instruction))
+    sendStatus(dxl, error, data.data(), (uint16_t)data.size());
+}
+
+void VirtualBus::processPacket2(uint8_t id, uint8_t instruction, const uint8_t *param, uint16_t param_length)
+{
+  std::vector<uint8_t> data;
+  VirtualDynamixel *dxl = findDynamixel(id);
+
+  if (instruction == INST_SYNC_READ || instruction == INST_SYNC_WRITE)
+  {
+    // START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H [ID (DATA...)]...
+    if (id != BROADCAST_ID || param_length < 4)
+      return;
+
+    uint16_t address  = DXL_MAKEWORD(param[0], param[1]);
+    uint16_t length   = DXL_MAKEWORD(param[2], param[3]);
+    int      step     = (instruction == INST_SYNC_READ) ? 1 : 1 + length;
+
+    for (int i = 4; i + step <= param_length; i += step)
+    {
+      dxl = findDynamixel(param[i]);
+      if (dxl == 0)
+        continue;
+      if (instruction == INST_SYNC_WRITE)
+      {
+        dxl->write(address, length, &param[i + 1]);
+      }
+      else if (isResponding(dxl, instruction))
+      {
+        data.resize(length);
+        uint8_t error = dxl->read(address, length, data.data());
+        sendStatus(dxl, error, data.data(), error ? 0 : length);
+      }
+    }
+    return;
+  }
+  if (instruction == INST_FAST_SYNC_READ)
+  {
+    // START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H [ID]...
+    if (id != BROADCAST_ID || param_length < 5)
+      return;
+
+    std::vector<uint8_t>  id_list(param + 4, param + param_length);
+    std::vector<uint16_t> address_list(id_list.size(), DXL_MAKEWORD(param[0], param[1]));
+    std::vector<uint16_t> length_list(id_list.size(), DXL_MAKEWORD(param[2], param[3]));
+    sendFastStatus(id_list, address_list, length_list);
+    return;
+  }
+  if (instruction == INST_FAST_BULK_READ)
+  {
+    // [ID START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H]...
+    if (id != BROADCAST_ID || param_length < 5)
+      return;
+
+    std::vector<uint8_t>  id_list;
+    std::vector<uint16_t> address_list;
+    std::vector<uint16_t> length_list;
+    for (int i = 0; i + 5 <= param_length; i += 5)
+    {
+      id_list.push_back(param[i]);
+      address_list.push_back(DXL_MAKEWORD(param[i + 1], param[i + 2]));
+      length_list.push_back(DXL_MAKEWORD(param[i + 3], param[i + 4]));
+    }
+    sendFastStatus(id_list, address_list, length_list);
+    return;
+  }
+  if (instruction == INST_BULK_READ || instruction == INST_BULK_WRITE)
+  {
+    // [ID START_ADDR_L START_ADDR_H DATA_LEN_L DATA_LEN_H (DATA...)]...
+    if (id != BROADCAST_ID)
+      return;
+
+    for (int i = 0; i + 5 <= param_length; )
+    {
+      uint16_t address  = DXL_MAKEWORD(param[i + 1], param[i + 2]);
+      uint16_t length   = DXL_MAKEWORD(param[i + 3], param[i + 4]);
+
+      dxl = findDynamixel(param[i]);
+      if (instruction == INST_BULK_WRITE)
+      {
+        if (i + 5 + length > param_length)
+          break;
+        if (dxl != 0)
+          dxl->write(address, length, &param[i + 5]);
+        i += 5 + length;
+      }
+      else
+      {
+        if (dxl != 0 && isResponding(dxl, instruction))
+        {
+          data.resize(length);
+          uint8_t error = dxl->read(address, length, data.data());
+          sendStatus(dxl, error, data.data(), error ? 0 : length);
+        }
+        i += 5;
+      }
+    }
+    return;
+  }
+
+  if (id == BROADCAST_ID)
+  {
+    std::vector<VirtualDynamixel *> dxl_list = dxl_list_;
+    std::sort(dxl_list.begin(), dxl_list.end(), compareID);
+
+    for (unsigned int i = 0; i < dxl_list.size(); i++)
+    {
+      dxl = findDynamixel(dxl_list[i]->getID());
+      if (dxl == 0)
+        continue;
+
+      if (instruction == INST_PING)
+      {
+        uint8_t info[3] = { DXL_LOBYTE(dxl->getModelNumber()), DXL_HIBYTE(dxl->getModelNumber()), dxl->getFirmwareVersion() };
+        sendStatus(dxl, 0, info, 3);
+      }
+      else if (instruction == INST_WRITE && param_length >= 2)
+        dxl->write(DXL_MAKEWORD(param[0], param[1]), param_length - 2, &param[2]);
+      else if (instruction == INST_REG_WRITE && param_length >= 2)
+        dxl->regWrite(DXL_MAKEWORD(param[0], param[1]), param_length - 2, &param[2]);
+      else if (instruction == INST_ACTION)
+        dxl->action();
+    }
+    return;
+  }
+
+  if (dxl == 0)
+    return;
+
+  uint8_t error = 0;
+  switch (instruction)
+  {
+    case INST_PING:
+      data.push_back(DXL_LOBYTE(dxl->getModelNumber()));
+      data.push_back(DXL_HIBYTE(dxl->getModelNumber()));
+      data.push_back(dxl->getFirmwareVersion());
+      break;
+
+    case INST_READ:
+      if (param_length != 4)
+      {
+        error = dxl->getInstructionError();
+        break;
+      }
+      data.resize(DXL_MAKEWORD(param[2], param[3]));
+      error = dxl->read(DXL_MAKEWORD(param[0], param[1]), (uint16_t)data.size(), data.data());
+      if (error != 0)
+        data.clear();
+      break;
+
+    case INST_WRITE:
+      if (param_length < 2)
+        error = dxl->getInstructionError();
+      else
+        error = dxl->write(DXL_MAKEWORD(param[0], param[1]), param_length - 2, &param[2]);
+      break;
+
+    case INST_REG_WRITE:
+      if (param_length < 2)
+        error = dxl->getInstructionError();
+      else
+        error = dxl->regWrite(DXL_MAKEWORD(param[0], param[1]), param_length - 2, &param[2]);
+      break;
+
+    case INST_ACTION:
+      error = dxl->action();
+      break;
+
+    case INST_CLEAR:
+      break;
+
+    case INST_FACTORY_RESET:
+      if (isResponding(dxl, instruction))
+        sendStatus(dxl, 0, 0, 0);
+      dxl->factoryReset((param_length >= 1) ? param[0] : 0xFF);
+      return;
+
+    case INST_REBOOT:
+      if (isResponding(dxl, instruction))
+        sendStatus(dxl, 0, 0, 0);
+      dxl->reboot();
+      return;
+
+    default:
+      error = dxl->getInstructionError();
+      break;
+  }
+
+  if (isResponding(dxl, instruction))
+    sendStatus(dxl, error, data.data(), (uint16_t)data.size());
+}
+
+int VirtualBus::parsePacket1()
+{
+  // HEADER0 HEADER1 ID LENGTH INST PARAM... CHECKSUM
+  std::vector<uint8_t> &rx = rx_buffer_;
+  unsigned int idx = 0;
+
+  while (idx + 1 < rx.size() && (rx[idx] != 0xFF || rx[idx + 1] != 0xFF))
+    idx++;
+  if (idx + 4 > rx.size())
+    return idx;
+
+  uint8_t id      = rx[idx + 2];
+  uint8_t length  = rx[idx + 3];
+  if (id == 0xFF || length < 2)   // not a header
+    return idx + 1;
+  if (idx + 4 + length > rx.size())
+    return idx;
+
+  uint8_t checksum = 0;
+  for (int i = 2; i < 3 + length; i++)
+    checksum += rx[idx + i];
+  checksum = ~checksum;
+
+  if (checksum != rx[idx + 3 + length])
+  {
+    VirtualDynamixel *dxl = findDynamixel(id);
+    if (dxl != 0)
+      sendStatus(dxl, dxl->getCRCError(), 0, 0);
+  }
+  else
+  {
+    for (unsigned int i = 0; i < dxl_list_.size(); i++)
+      dxl_list_[i]->update(getCurrentTime());
+    processPacket1(id, rx[idx + 4], &rx[idx + 5], length - 2);
+  }
+  return idx + 4 + length;
+}
+
+int VirtualBus::parsePacket2()
+{
+  // HEADER0 HEADER1 HEADER2 RESERVED ID LENGTH_L LENGTH_H INST PARAM... CRC16_L CRC16_H
+  std::vector<uint8_t> &rx = rx_buffer_;
+  unsigned int idx = 0;
+
+  while (idx + 3 < rx.size() && (rx[idx] != 0xFF || rx[idx + 1] != 0xFF || rx[idx + 2] != 0xFD || rx[idx + 3] != 0x00))
+    idx++;
+  if (idx + 7 > rx.size())
+    return idx;
+
+  uint8_t   id      = rx[idx + 4];
+  uint16_t  length  = DXL_MAKEWORD(rx[idx + 5], rx[idx + 6]);
+  if (id == 0xFF || length < 3 || length > MAX_PACKET_LENGTH)   // not a header
+    return idx + 1;
+  if (idx + 7 + length > rx.size())
+    return idx;
+
+  uint16_t crc = updateCRC(0, &rx[idx], 5 + length);
+  if (crc != DXL_MAKEWORD(rx[idx + 5 + length], rx[idx + 6 + length]))
+  {
+    VirtualDynamixel *dxl = findDynamixel(id);
+    if (dxl != 0)
+      sendStatus(dxl, dxl->getCRCError(), 0, 0);
+    return idx + 7 + length;
+  }
+
+  // remove byte stuffing
+  std::vector<uint8_t> param;
+  for (int i = 8; i < 5 + length; i++)
+  {
+    size_t size = param.size();
+    if (rx[idx + i] == 0xFD && size >= 3 && param[size - 3] == 0xFF && param[size - 2] == 0xFF && param[size - 1] == 0xFD)
+      continue;
+    param.push_back(rx[idx + i]);
+  }
+
+  for (unsigned int i = 0; i < dxl_list_.size(); i++)
+    dxl_list_[i]->update(getCurrentTime());
+  processPacket2(id, rx[idx + 7], param.data(), (uint16_t)param.size());
+  return idx + 7 + length;
+}
+
+void VirtualBus::run(int msec)
+{
+  uint8_t buffer[RX_CHUNK_SIZE];
+  double  end_time = getCurrentTime() + msec * 0.001;
+
+  do
+  {
+    struct pollfd pfd;
+    pfd.fd      = master_fd_;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+
+    int timeout = (msec < 0) ? 0 : (int)((end_time - getCurrentTime()) * 1000.0) + 1;
+    if (poll(&pfd, 1, timeout) <= 0 || (pfd.revents & POLLIN) == 0)
+      continue;
+
+    int n = read(master_fd_, buffer, sizeof(buffer));
+    if (n <= 0)
+      continue;
+
+    // the bytes arrive one after another on the bus
+    bus_free_time_ = std::max(bus_free_time_, getCurrentTime()) + n * getByteTime();
+    rx_buffer_.insert(rx_buffer_.end(), buffer, buffer + n);
+
+    while (rx_buffer_.empty() == false)
+    {
+      unsigned int size = (unsigned int)rx_buffer_.size();
+      int used = (protocol_version_ == 1.0) ? parsePacket1() : parsePacket2();
+      if (used == 0)
+        break;
+      rx_buffer_.erase(rx_buffer_.begin(), rx_buffer_.begin() + used);
+      if (rx_buffer_.size() == size)
+        break;
+    }
+  } while (msec >= 0 && getCurrentTime() < end_time);
+}
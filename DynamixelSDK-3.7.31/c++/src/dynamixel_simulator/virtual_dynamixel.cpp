@@ -0,0 +1,552 @@
+/*******************************************************************************
+* Copyright 2017 ROBOTIS CO., LTD.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include "virtual_dynamixel.h"
+
+#define ACCESS_NONE     0
+#define ACCESS_R        1
+#define ACCESS_RW       2
+#define ACCESS_EEPROM   3   // RW only while the torque is off
+
+// Protocol 2.0 error numbers
+#define ERRNUM_INSTRUCTION  2
+#define ERRNUM_CRC          3
+#define ERRNUM_DATA_RANGE   4
+#define ERRNUM_ACCESS       7
+
+// Protocol 1.0 error bits
+#define ERRBIT_RANGE        8
+#define ERRBIT_CHECKSUM     16
+#define ERRBIT_INSTRUCTION  64
+
+using namespace dynamixel;
+
+namespace
+{
+
+// XM430-W350 (Protocol 2.0)
+#define XM_MODEL_NUMBER           0
+#define XM_FIRMWARE_VERSION       6
+#define XM_ID                     7
+#define XM_BAUD_RATE              8
+#define XM_RETURN_DELAY_TIME      9
+#define XM_OPERATING_MODE         11
+#define XM_MOVING_THRESHOLD       24
+#define XM_VELOCITY_LIMIT         44
+#define XM_MAX_POSITION_LIMIT     48
+#define XM_MIN_POSITION_LIMIT     52
+#define XM_TORQUE_ENABLE          64
+#define XM_STATUS_RETURN_LEVEL    68
+#define XM_REGISTERED_INSTRUCTION 69
+#define XM_GOAL_VELOCITY          104
+#define XM_PROFILE_VELOCITY       112
+#define XM_GOAL_POSITION          116
+#define XM_REALTIME_TICK          120
+#define XM_MOVING                 122
+#define XM_PRESENT_VELOCITY       128
+#define XM_PRESENT_POSITION       132
+#define XM_INDIRECT_ADDRESS_1     168
+#define XM_INDIRECT_DATA_1        224
+#define XM_INDIRECT_ADDRESS_29    578
+#define XM_INDIRECT_DATA_29       634
+#define XM_INDIRECT_COUNT         28
+#define XM_TABLE_SIZE             662
+
+const VirtualDynamixel::ControlTableItem XM430_W350_ITEMS[] =
+{
+  {   0, 2, ACCESS_R,      1020 },  // Model Number
+  {   2, 4, ACCESS_R,      0    },  // Model Information
+  {   6, 1, ACCESS_R,      45   },  // Firmware Version
+  {   7, 1, ACCESS_EEPROM, 1    },  // ID
+  {   8, 1, ACCESS_EEPROM, 1    },  // Baud Rate
+  {   9, 1, ACCESS_EEPROM, 250  },  // Return Delay Time
+  {  10, 1, ACCESS_EEPROM, 0    },  // Drive Mode
+  {  11, 1, ACCESS_EEPROM, 3    },  // Operating Mode
+  {  12, 1, ACCESS_EEPROM, 255  },  // Secondary ID
+  {  13, 1, ACCESS_EEPROM, 2    },  // Protocol Type
+  {  20, 4, ACCESS_EEPROM, 0    },  // Homing Offset
+  {  24, 4, ACCESS_EEPROM, 10   },  // Moving Threshold
+  {  31, 1, ACCESS_EEPROM, 80   },  // Temperature Limit
+  {  32, 2, ACCESS_EEPROM, 160  },  // Max Voltage Limit
+  {  34, 2, ACCESS_EEPROM, 95   },  // Min Voltage Limit
+  {  36, 2, ACCESS_EEPROM, 885  },  // PWM Limit
+  {  38, 2, ACCESS_EEPROM, 1193 },  // Current Limit
+  {  44, 4, ACCESS_EEPROM, 200  },  // Velocity Limit
+  {  48, 4, ACCESS_EEPROM, 4095 },  // Max Position Limit
+  {  52, 4, ACCESS_EEPROM, 0    },  // Min Position Limit
+  {  63, 1, ACCESS_EEPROM, 52   },  // Shutdown
+  {  64, 1, ACCESS_RW,     0    },  // Torque Enable
+  {  65, 1, ACCESS_RW,     0    },  // LED
+  {  68, 1, ACCESS_RW,     2    },  // Status Return Level
+  {  69, 1, ACCESS_R,      0    },  // Registered Instruction
+  {  70, 1, ACCESS_R,      0    },  // Hardware Error Status
+  {  76, 2, ACCESS_RW,     1920 },  // Velocity I Gain
+  {  78, 2, ACCESS_RW,     100  },  // Velocity P Gain
+  {  80, 2, ACCESS_RW,     0    },  // Position D Gain
+  {  82, 2, ACCESS_RW,     0    },  // Position I Gain
+  {  84, 2, ACCESS_RW,     800  },  // Position P Gain
+  {  88, 2, ACCESS_RW,     0    },  // Feedforward 2nd Gain
+  {  90, 2, ACCESS_RW,     0    },  // Feedforward 1st Gain
+  {  98, 1, ACCESS_RW,     0    },  // Bus Watchdog
+  { 100, 2, ACCESS_RW,     0    },  // Goal PWM
+  { 102, 2, ACCESS_RW,     0    },  // Goal Current
+  { 104, 4, ACCESS_RW,     0    },  // Goal Velocity
+  { 108, 4, ACCESS_RW,     0    },  // Profile Acceleration
+  { 112, 4, ACCESS_RW,     0    },  // Profile Velocity
+  { 116, 4, ACCESS_RW,     2048 },  // Goal Position
+  { 120, 2, ACCESS_R,      0    },  // Realtime Tick
+  { 122, 1, ACCESS_R,      0    },  // Moving
+  { 123, 1, ACCESS_R,      0    },  // Moving Status
+  { 124, 2, ACCESS_R,      0    },  // Present PWM
+  { 126, 2, ACCESS_R,      0    },  // Present Current
+  { 128, 4, ACCESS_R,      0    },  // Present Velocity
+  { 132, 4, ACCESS_R,      2048 },  // Present Position
+  { 136, 4, ACCESS_R,      0    },  // Velocity Trajectory
+  { 140, 4, ACCESS_R,      2048 },  // Position Trajectory
+  { 144, 2, ACCESS_R,      120  },  // Present Input Voltage
+  { 146, 1, ACCESS_R,      30   },  // Present Temperature
+};
+
+// MX-28 (Protocol 1.0)
+#define MX_MODEL_NUMBER           0
+#define MX_FIRMWARE_VERSION       2
+#define MX_ID                     3
+#define MX_BAUD_RATE              4
+#define MX_RETURN_DELAY_TIME      5
+#define MX_STATUS_RETURN_LEVEL    16
+#define MX_TORQUE_ENABLE          24
+#define MX_GOAL_POSITION          30
+#define MX_MOVING_SPEED           32
+#define MX_PRESENT_POSITION       36
+#define MX_PRESENT_SPEED          38
+#define MX_REGISTERED             44
+#define MX_MOVING                 46
+#define MX_TABLE_SIZE             74
+
+const VirtualDynamixel::ControlTableItem MX28_ITEMS[] =
+{
+  {  0, 2, ACCESS_R,      29   },   // Model Number
+  {  2, 1, ACCESS_R,      30   },   // Firmware Version
+  {  3, 1, ACCESS_EEPROM, 1    },   // ID
+  {  4, 1, ACCESS_EEPROM, 34   },   // Baud Rate
+  {  5, 1, ACCESS_EEPROM, 250  },   // Return Delay Time
+  {  6, 2, ACCESS_EEPROM, 0    },   // CW Angle Limit
+  {  8, 2, ACCESS_EEPROM, 4095 },   // CCW Angle Limit
+  { 11, 1, ACCESS_EEPROM, 80   },   // Temperature Limit
+  { 12, 1, ACCESS_EEPROM, 60   },   // Min Voltage Limit
+  { 13, 1, ACCESS_EEPROM, 160  },   // Max Voltage Limit
+  { 14, 2, ACCESS_EEPROM, 1023 },   // Max Torque
+  { 16, 1, ACCESS_EEPROM, 2    },   // Status Return Level
+  { 17, 1, ACCESS_EEPROM, 36   },   // Alarm LED
+  { 18, 1, ACCESS_EEPROM, 36   },   // Shutdown
+  { 20, 2, ACCESS_EEPROM, 0    },   // Multi Turn Offset
+  { 22, 1, ACCESS_EEPROM, 1    },   // Resolution Divider
+  { 24, 1, ACCESS_RW,     0    },   // Torque Enable
+  { 25, 1, ACCESS_RW,     0    },   // LED
+  { 26, 1, ACCESS_RW,     0    },   // D Gain
+  { 27, 1, ACCESS_RW,     0    },   // I Gain
+  { 28, 1, ACCESS_RW,     32   },   // P Gain
+  { 30, 2, ACCESS_RW,     2048 },   // Goal Position
+  { 32, 2, ACCESS_RW,     0    },   // Moving Speed
+  { 34, 2, ACCESS_RW,     1023 },   // Torque Limit
+  { 36, 2, ACCESS_R,      2048 },   // Present Position
+  { 38, 2, ACCESS_R,      0    },   // Present Speed
+  { 40, 2, ACCESS_R,      0    },   // Present Load
+  { 42, 1, ACCESS_R,      120  },   // Present Voltage
+  { 43, 1, ACCESS_R,      30   },   // Present Temperature
+  { 44, 1, ACCESS_R,      0    },   // Registered
+  { 46, 1, ACCESS_R,      0    },   // Moving
+  { 47, 1, ACCESS_RW,     0    },   // Lock
+  { 48, 2, ACCESS_RW,     0    },   // Punch
+  { 73, 1, ACCESS_RW,     0    },   // Goal Acceleration
+};
+
+const int XM_BAUDRATES[] = { 9600, 57600, 115200, 1000000, 2000000, 3000000, 4000000, 4500000 };
+
+int32_t getValue(const std::vector<uint8_t> &table, uint16_t address, uint8_t size)
+{
+  uint32_t value = 0;
+  for (int i = size - 1; i >= 0; i--)
+    value = (value << 8) | table[address + i];
+
+  if (size == 2)
+    return (int16_t)value;
+  return (int32_t)value;
+}
+
+void setValue(std::vector<uint8_t> &table, uint16_t address, uint8_t size, int32_t value)
+{
+  for (int i = 0; i < size; i++)
+    table[address + i] = (uint8_t)(((uint32_t)value >> (8 * i)) & 0xFF);
+}
+
+int getXMBaudRate(uint8_t value)
+{
+  if (value < sizeof(XM_BAUDRATES) / sizeof(XM_BAUDRATES[0]))
+    return XM_BAUDRATES[value];
+  return -1;
+}
+
+int getMXBaudRate(uint8_t value)
+{
+  if (value < 250)
+    return 2000000 / (value + 1);
+  if (value == 250)
+    return 2250000;
+  if (value == 251)
+    return 2500000;
+  if (value == 252)
+    return 3000000;
+  return -1;
+}
+
+}
+
+VirtualDynamixel::VirtualDynamixel(uint8_t id, float protocol_version, int baudrate, int return_delay_usec)
+  : protocol_version_(protocol_version),
+    default_id_(id),
+    default_baudrate_(baudrate),
+    default_return_delay_(return_delay_usec < 0 ? 500 : return_delay_usec),
+    registered_address_(0),
+    position_(2048.0),
+    last_update_time_(-1.0)
+{
+  if (protocol_version_ == 1.0)
+  {
+    items_      = MX28_ITEMS;
+    item_count_ = sizeof(MX28_ITEMS) / sizeof(MX28_ITEMS[0]);
+    table_.resize(MX_TABLE_SIZE);
+  }
+  else
+  {
+    items_      = XM430_W350_ITEMS;
+    item_count_ = sizeof(XM430_W350_ITEMS) / sizeof(XM430_W350_ITEMS[0]);
+    table_.resize(XM_TABLE_SIZE);
+  }
+  access_.resize(table_.size());
+
+  for (int i = 0; i < item_count_; i++)
+  {
+    for (int j = 0; j < items_[i].size; j++)
+      access_[items_[i].address + j] = items_[i].access;
+  }
+  if (protocol_version_ != 1.0)
+  {
+    for (int i = 0; i < XM_INDIRECT_COUNT; i++)
+    {
+      access_[XM_INDIRECT_ADDRESS_1 + 2 * i]      = ACCESS_EEPROM;
+      access_[XM_INDIRECT_ADDRESS_1 + 2 * i + 1]  = ACCESS_EEPROM;
+      access_[XM_INDIRECT_DATA_1 + i]             = ACCESS_RW;
+      access_[XM_INDIRECT_ADDRESS_29 + 2 * i]     = ACCESS_EEPROM;
+      access_[XM_INDIRECT_ADDRESS_29 + 2 * i + 1] = ACCESS_EEPROM;
+      access_[XM_INDIRECT_DATA_29 + i]            = ACCESS_RW;
+    }
+  }
+
+  initialize(false, false);
+
+  // the settings given by the simulator instead of the factory settings
+  uint8_t return_delay = (uint8_t)(default_return_delay_ / 2 > 254 ? 254 : default_return_delay_ / 2);
+  if (protocol_version_ == 1.0)
+  {
+    uint8_t baud = 34;
+    for (int v = 0; v <= 252; v++)
+    {
+      int b = getMXBaudRate(v);
+      if (abs(b - baudrate) < abs(getMXBaudRate(baud) - baudrate))
+        baud = v;
+    }
+    table_[MX_ID]               = id;
+    table_[MX_BAUD_RATE]        = baud;
+    table_[MX_RETURN_DELAY_TIME] = return_delay;
+  }
+  else
+  {
+    uint8_t baud = 1;
+    for (unsigned int v = 0; v < sizeof(XM_BAUDRATES) / sizeof(XM_BAUDRATES[0]); v++)
+    {
+      if (XM_BAUDRATES[v] == baudrate)
+        baud = v;
+    }
+    table_[XM_ID]               = id;
+    table_[XM_BAUD_RATE]        = baud;
+    table_[XM_RETURN_DELAY_TIME] = return_delay;
+  }
+}
+
+void VirtualDynamixel::initialize(bool keep_id, bool keep_baudrate)
+{
+  uint8_t id    = getID();
+  uint8_t baud  = table_[(protocol_version_ == 1.0) ? MX_BAUD_RATE : XM_BAUD_RATE];
+
+  for (unsigned int i = 0; i < table_.size(); i++)
+    table_[i] = 0;
+  for (int i = 0; i < item_count_; i++)
+    setValue(table_, items_[i].address, items_[i].size, items_[i].initial_value);
+
+  if (protocol_version_ != 1.0)
+  {
+    for (int i = 0; i < XM_INDIRECT_COUNT; i++)
+    {
+      setValue(table_, XM_INDIRECT_ADDRESS_1 + 2 * i, 2, XM_INDIRECT_DATA_1 + i);
+      setValue(table_, XM_INDIRECT_ADDRESS_29 + 2 * i, 2, XM_INDIRECT_DATA_29 + i);
+    }
+  }
+
+  if (keep_id)
+    table_[(protocol_version_ == 1.0) ? MX_ID : XM_ID] = id;
+  if (keep_baudrate)
+    table_[(protocol_version_ == 1.0) ? MX_BAUD_RATE : XM_BAUD_RATE] = baud;
+
+  // the horn stays where it is
+  if (protocol_version_ == 1.0)
+  {
+    setValue(table_, MX_GOAL_POSITION, 2, (int32_t)position_);
+    setValue(table_, MX_PRESENT_POSITION, 2, (int32_t)position_);
+  }
+  else
+  {
+    setValue(table_, XM_GOAL_POSITION, 4, (int32_t)position_);
+    setValue(table_, XM_PRESENT_POSITION, 4, (int32_t)position_);
+  }
+  registered_data_.clear();
+}
+
+uint8_t VirtualDynamixel::getID()
+{
+  return table_[(protocol_version_ == 1.0) ? MX_ID : XM_ID];
+}
+
+float VirtualDynamixel::getProtocolVersion()
+{
+  return protocol_version_;
+}
+
+int VirtualDynamixel::getBaudRate()
+{
+  if (protocol_version_ == 1.0)
+    return getMXBaudRate(table_[MX_BAUD_RATE]);
+  return getXMBaudRate(table_[XM_BAUD_RATE]);
+}
+
+double VirtualDynamixel::getReturnDelayTime()
+{
+  return table_[(protocol_version_ == 1.0) ? MX_RETURN_DELAY_TIME : XM_RETURN_DELAY_TIME] * 2.0;
+}
+
+uint8_t VirtualDynamixel::getStatusReturnLevel()
+{
+  return table_[(protocol_version_ == 1.0) ? MX_STATUS_RETURN_LEVEL : XM_STATUS_RETURN_LEVEL];
+}
+
+uint16_t VirtualDynamixel::getModelNumber()
+{
+  return (uint16_t)getValue(table_, (protocol_version_ == 1.0) ? MX_MODEL_NUMBER : XM_MODEL_NUMBER, 2);
+}
+
+uint8_t VirtualDynamixel::getFirmwareVersion()
+{
+  return table_[(protocol_version_ == 1.0) ? MX_FIRMWARE_VERSION : XM_FIRMWARE_VERSION];
+}
+
+uint16_t VirtualDynamixel::getControlTableSize()
+{
+  return (uint16_t)table_.size();
+}
+
+uint8_t VirtualDynamixel::getInstructionError()
+{
+  return (protocol_version_ == 1.0) ? ERRBIT_INSTRUCTION : ERRNUM_INSTRUCTION;
+}
+
+uint8_t VirtualDynamixel::getCRCError()
+{
+  return (protocol_version_ == 1.0) ? ERRBIT_CHECKSUM : ERRNUM_CRC;
+}
+
+uint16_t VirtualDynamixel::getIndirectAddress(uint16_t address)
+{
+  if (protocol_version_ == 1.0)
+    return address;
+
+  uint16_t target = address;
+  if (address >= XM_INDIRECT_DATA_1 && address < XM_INDIRECT_DATA_1 + XM_INDIRECT_COUNT)
+    target = (uint16_t)getValue(table_, XM_INDIRECT_ADDRESS_1 + 2 * (address - XM_INDIRECT_DATA_1), 2);
+  else if (address >= XM_INDIRECT_DATA_29 && address < XM_INDIRECT_DATA_29 + XM_INDIRECT_COUNT)
+    target = (uint16_t)getValue(table_, XM_INDIRECT_ADDRESS_29 + 2 * (address - XM_INDIRECT_DATA_29), 2);
+
+  // an indirect address pointing to an indirect data is the storage of itself
+  if (target >= table_.size() ||
+      (target >= XM_INDIRECT_DATA_1 && target < XM_INDIRECT_DATA_1 + XM_INDIRECT_COUNT) ||
+      (target >= XM_INDIRECT_DATA_29 && target < XM_INDIRECT_DATA_29 + XM_INDIRECT_COUNT))
+    return address;
+  return target;
+}
+
+void VirtualDynamixel::update(double now)
+{
+  double dt = (last_update_time_ < 0.0) ? 0.0 : now - last_update_time_;
+  last_update_time_ = now;
+
+  if (protocol_version_ == 1.0)
+  {
+    double goal   = getValue(table_, MX_GOAL_POSITION, 2);
+    int    speed  = getValue(table_, MX_MOVING_SPEED, 2) & 0x3FF;
+    double rpm    = ((speed == 0) ? 1023 : speed) * 0.114;
+    double step   = rpm / 60.0 * 4096.0 * dt;
+    double diff   = goal - position_;
+
+    if (table_[MX_TORQUE_ENABLE] == 0)
+      rpm = 0.0;
+    else if (fabs(diff) <= step)
+      position_ = goal;
+    else
+      position_ += (diff > 0.0) ? step : -step;
+
+    bool moving = table_[MX_TORQUE_ENABLE] != 0 && position_ != goal;
+    setValue(table_, MX_PRESENT_POSITION, 2, (int32_t)position_);
+    setValue(table_, MX_PRESENT_SPEED, 2, moving ? ((int32_t)(rpm / 0.114) | ((diff < 0.0) ? 0x400 : 0)) : 0);
+    table_[MX_MOVING] = moving ? 1 : 0;
+    return;
+  }
+
+  bool    torque  = table_[XM_TORQUE_ENABLE] != 0;
+  uint8_t mode    = table_[XM_OPERATING_MODE];
+  double  velocity = 0.0;   // rpm
+  bool    moving  = false;
+
+  if (torque && mode == 1)  // velocity control
+  {
+    velocity  = getValue(table_, XM_GOAL_VELOCITY, 4) * 0.229;
+    position_ += velocity / 60.0 * 4096.0 * dt;
+    moving    = velocity != 0.0;
+  }
+  else if (torque)          // position control
+  {
+    double goal = getValue(table_, XM_GOAL_POSITION, 4);
+    if (mode == 3)
+    {
+      double max_position = getValue(table_, XM_MAX_POSITION_LIMIT, 4);
+      double min_position = getValue(table_, XM_MIN_POSITION_LIMIT, 4);
+      goal = (goal > max_position) ? max_position : ((goal < min_position) ? min_position : goal);
+    }
+
+    int32_t profile = getValue(table_, XM_PROFILE_VELOCITY, 4);
+    double  rpm     = ((profile > 0) ? profile : getValue(table_, XM_VELOCITY_LIMIT, 4)) * 0.229;
+    double  step    = rpm / 60.0 * 4096.0 * dt;
+    double  diff    = goal - position_;
+
+    if (fabs(diff) <= step)
+      position_ = goal;
+    else
+      position_ += (diff > 0.0) ? step : -step;
+
+    if (position_ != goal)
+      velocity = (diff > 0.0) ? rpm : -rpm;
+    moving = fabs(goal - position_) > getValue(table_, XM_MOVING_THRESHOLD, 4);
+  }
+
+  setValue(table_, XM_PRESENT_POSITION, 4, (int32_t)floor(position_ + 0.5));
+  setValue(table_, XM_PRESENT_VELOCITY, 4, (int32_t)(velocity / 0.229));
+  setValue(table_, XM_REALTIME_TICK, 2, (int32_t)fmod(now * 1000.0, 32768.0));
+  table_[XM_MOVING] = moving ? 1 : 0;
+}
+
+uint8_t VirtualDynamixel::read(uint16_t address, uint16_t length, uint8_t *data)
+{
+  if ((int)address + length > (int)table_.size())
+    return (protocol_version_ == 1.0) ? ERRBIT_RANGE : ERRNUM_ACCESS;
+
+  for (uint16_t i = 0; i < length; i++)
+    data[i] = table_[getIndirectAddress(address + i)];
+  return 0;
+}
+
+uint8_t VirtualDynamixel::write(uint16_t address, uint16_t length, const uint8_t *data)
+{
+  uint8_t access_error = (protocol_version_ == 1.0) ? ERRBIT_RANGE : ERRNUM_ACCESS;
+  uint8_t range_error  = (protocol_version_ == 1.0) ? ERRBIT_RANGE : ERRNUM_DATA_RANGE;
+  bool    torque       = table_[(protocol_version_ == 1.0) ? MX_TORQUE_ENABLE : XM_TORQUE_ENABLE] != 0;
+  uint16_t id_address  = (protocol_version_ == 1.0) ? MX_ID : XM_ID;
+  uint16_t baud_address = (protocol_version_ == 1.0) ? MX_BAUD_RATE : XM_BAUD_RATE;
+
+  if ((int)address + length > (int)table_.size())
+    return access_error;
+
+  // check every byte before writing any of them
+  for (uint16_t i = 0; i < length; i++)
+  {
+    uint16_t target = getIndirectAddress(address + i);
+    uint8_t  access = access_[target];
+
+    if (access == ACCESS_NONE || access == ACCESS_R || (access == ACCESS_EEPROM && torque))
+      return access_error;
+    if (target == id_address && data[i] > 252)
+      return range_error;
+    if (target == baud_address && ((protocol_version_ == 1.0) ? getMXBaudRate(data[i]) : getXMBaudRate(data[i])) < 0)
+      return range_error;
+  }
+
+  for (uint16_t i = 0; i < length; i++)
+    table_[getIndirectAddress(address + i)] = data[i];
+  return 0;
+}
+
+uint8_t VirtualDynamixel::regWrite(uint16_t address, uint16_t length, const uint8_t *data)
+{
+  if ((int)address + length > (int)table_.size())
+    return (protocol_version_ == 1.0) ? ERRBIT_RANGE : ERRNUM_ACCESS;
+
+  registered_address_ = address;
+  registered_data_.assign(data, data + length);
+  table_[(protocol_version_ == 1.0) ? MX_REGISTERED : XM_REGISTERED_INSTRUCTION] = 1;
+  return 0;
+}
+
+uint8_t VirtualDynamixel::action()
+{
+  uint16_t registered = (protocol_version_ == 1.0) ? MX_REGISTERED : XM_REGISTERED_INSTRUCTION;
+
+  if (table_[registered] == 0)
+    return 0;
+
+  table_[registered] = 0;
+  uint8_t error = write(registered_address_, (uint16_t)registered_data_.size(), registered_data_.data());
+  registered_data_.clear();
+  return error;
+}
+
+uint8_t VirtualDynamixel::factoryReset(uint8_t option)
+{
+  // 0xFF : reset all, 0x01 : reset all except ID, 0x02 : reset all except ID and baudrate
+  initialize(option == 0x01 || option == 0x02, option == 0x02);
+  return 0;
+}
+
+uint8_t VirtualDynamixel::reboot()
+{
+  std::vector<uint8_t> eeprom = table_;
+
+  initialize(false, false);
+  for (unsigned int i = 0; i < table_.size(); i++)
+  {
+    if (access_[i] == ACCESS_EEPROM)
+      table_[i] = eeprom[i];
+  }
+  return 0;
+}